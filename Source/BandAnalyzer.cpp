@@ -0,0 +1,192 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "BandAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    float powerToDecibels(double power) noexcept
+    {
+        return power > 0.0 ? std::max(BandAnalyzer::floorDecibels, (float) (10.0 * std::log10(power)))
+                           : BandAnalyzer::floorDecibels;
+    }
+}
+
+//==============================================================================
+BandAnalyzer::BandAnalyzer()
+    : queue((size_t) queueCapacity)
+{
+}
+
+void BandAnalyzer::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = std::max(0, std::min(newNumChannels, maxChannels));
+
+    // BS.1770 K-weighting at any rate: the analogue prototypes of its 48 kHz
+    // coefficients through the bilinear transform (as in libebur128)
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    reset();
+}
+
+void BandAnalyzer::reset() noexcept
+{
+    for (auto& channel : filterStates)
+        for (auto& band : channel)
+            band.fill(0.0);
+
+    windowStart = 0;
+    startWindow();
+}
+
+void BandAnalyzer::setWindowSeconds(double seconds) noexcept
+{
+    requestedWindowSeconds.store(std::max(0.001, seconds), std::memory_order_relaxed);
+}
+
+void BandAnalyzer::startWindow() noexcept
+{
+    windowLength = std::max(1, (int) std::lround(requestedWindowSeconds.load(std::memory_order_relaxed) * sampleRate));
+    windowFilled = 0;
+    sumSquares.fill(0.0);
+    weightedSumSquares.fill(0.0);
+    peaks.fill(0.0f);
+}
+
+//==============================================================================
+void BandAnalyzer::process(const float* const* const* bands, int numChannelsToMeasure, int numSamples) noexcept
+{
+    numChannelsToMeasure = std::min(numChannelsToMeasure, numChannels);
+    if (numChannelsToMeasure <= 0)
+        return;
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int n = std::min(numSamples - start, windowLength - windowFilled);
+
+        for (int band = 0; band < numBands; ++band)
+        {
+            double squares = 0.0, weightedSquares = 0.0;
+            float peak = peaks[(size_t) band];
+
+            for (int channel = 0; channel < numChannelsToMeasure; ++channel)
+            {
+                const float* data = bands[band][channel] + start;
+                auto& z = filterStates[(size_t) channel][(size_t) band];
+                double z1 = z[0], z2 = z[1], z3 = z[2], z4 = z[3];
+
+                for (int i = 0; i < n; ++i)
+                {
+                    const double x = data[i];
+                    squares += x * x;
+                    peak = std::max(peak, std::abs(data[i]));
+
+                    const double shelved = shelf.b0 * x + z1;
+                    z1 = shelf.b1 * x - shelf.a1 * shelved + z2;
+                    z2 = shelf.b2 * x - shelf.a2 * shelved;
+
+                    const double weighted = highPass.b0 * shelved + z3;
+                    z3 = highPass.b1 * shelved - highPass.a1 * weighted + z4;
+                    z4 = highPass.b2 * shelved - highPass.a2 * weighted;
+
+                    weightedSquares += weighted * weighted;
+                }
+
+                z = { z1, z2, z3, z4 };
+            }
+
+            sumSquares[(size_t) band] += squares;
+            weightedSumSquares[(size_t) band] += weightedSquares;
+            peaks[(size_t) band] = peak;
+        }
+
+        windowChannels = numChannelsToMeasure;
+        windowFilled += n;
+        start += n;
+        if (windowFilled == windowLength)
+            completeWindow();
+    }
+}
+
+void BandAnalyzer::flush() noexcept
+{
+    if (windowFilled > 0)
+        completeWindow();
+}
+
+void BandAnalyzer::completeWindow() noexcept
+{
+    Frame frame;
+    frame.firstSample = windowStart;
+    frame.numSamples = (std::uint32_t) windowFilled;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        // RMS averages the channels' power, loudness sums it (BS.1770, all channel weights 1)
+        frame.rmsDb[band] = powerToDecibels(sumSquares[(size_t) band] / ((double) windowFilled * windowChannels));
+        frame.peakDb[band] = powerToDecibels((double) peaks[(size_t) band] * peaks[(size_t) band]);
+        frame.loudnessLufs[band] = std::max(floorDecibels,
+                                            -0.691f + powerToDecibels(weightedSumSquares[(size_t) band] / windowFilled));
+    }
+    push(frame);
+
+    windowStart += (std::uint64_t) windowFilled;
+    startWindow();
+}
+
+//==============================================================================
+void BandAnalyzer::push(const Frame& frame) noexcept
+{
+    const auto write = writeIndex.load(std::memory_order_relaxed);
+    if (write - readIndex.load(std::memory_order_acquire) >= (std::uint32_t) queueCapacity)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    queue[write % (std::uint32_t) queueCapacity] = frame;
+    writeIndex.store(write + 1, std::memory_order_release);
+}
+
+bool BandAnalyzer::pop(Frame& frame) noexcept
+{
+    const auto read = readIndex.load(std::memory_order_relaxed);
+    if (read == writeIndex.load(std::memory_order_acquire))
+        return false;
+
+    frame = queue[read % (std::uint32_t) queueCapacity];
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+}
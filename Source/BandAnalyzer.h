@@ -0,0 +1,99 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * Per-band level measurement on the split the isolator already computes.
+ *
+ * Over consecutive windows of a configurable length, each band gets its RMS
+ * (power averaged over channels), sample peak and ITU-R BS.1770 loudness
+ * (K-weighted, summed over channels; the momentary measure for a 400 ms
+ * window). Each completed window is pushed as a Frame to a fixed
+ * single-producer / single-consumer queue: the audio thread measures, one
+ * other thread (editor timer, file writer) pops. A full queue drops frames
+ * and counts them.
+ *
+ * JUCE-free, part of the core library. Allocates in the constructor only.
+ */
+class BandAnalyzer
+{
+public:
+    static constexpr int numBands = 4;
+    static constexpr int maxChannels = 8;
+    static constexpr int queueCapacity = 256;
+    static constexpr double defaultWindowSeconds = 0.4;
+
+    // Reported for silence instead of -inf
+    static constexpr float floorDecibels = -150.0f;
+
+    struct Frame
+    {
+        std::uint64_t firstSample = 0; // start of the window, in samples measured since reset()
+        std::uint32_t numSamples = 0;
+        float rmsDb[numBands] {};      // dBFS (a full-scale sine reads -3 dB)
+        float peakDb[numBands] {};     // dBFS
+        float loudnessLufs[numBands] {};
+    };
+
+    BandAnalyzer();
+
+    /** Designs the K-weighting for the rate and restarts measuring; not concurrent with process(). */
+    void prepare(double sampleRate, int numChannels);
+
+    /** Restarts the window, the position and the K-weighting filters (producer side; the queue is kept). */
+    void reset() noexcept;
+
+    /** Any thread; takes effect from the next window. */
+    void setWindowSeconds(double seconds) noexcept;
+
+    //==============================================================================
+    /** Producer: measures bands[band][channel] (numSamples each), pushing every window it completes. */
+    void process(const float* const* const* bands, int numChannels, int numSamples) noexcept;
+
+    /** Producer: pushes the window in progress, if any, as a shorter frame (end of a file). */
+    void flush() noexcept;
+
+    /** Consumer: the oldest frame, false if there is none. */
+    bool pop(Frame& frame) noexcept;
+
+    /** Frames lost to a full queue since construction. */
+    int getNumDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    // Two cascaded biquads (TDF-II) per band and channel: the BS.1770 shelf, then its high-pass
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    void push(const Frame& frame) noexcept;
+    void startWindow() noexcept;
+    void completeWindow() noexcept;
+
+    double sampleRate = 48000.0;
+    int numChannels = 0;
+    Biquad shelf, highPass;
+    std::array<std::array<std::array<double, 4>, numBands>, maxChannels> filterStates {};
+
+    std::atomic<double> requestedWindowSeconds { defaultWindowSeconds };
+    int windowLength = 0;
+    int windowFilled = 0;
+    int windowChannels = 1;
+    std::uint64_t windowStart = 0;
+    std::array<double, numBands> sumSquares {}, weightedSumSquares {};
+    std::array<float, numBands> peaks {};
+
+    std::vector<Frame> queue;
+    std::atomic<std::uint32_t> writeIndex { 0 }, readIndex { 0 };
+    std::atomic<int> dropped { 0 };
+};
@@ -0,0 +1,81 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "CpuGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+void CpuGovernor::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void CpuGovernor::reset() noexcept
+{
+    tier = tierFull;
+    load = 0.0f;
+    secondsSinceChange = 0.0;
+    secondsWithHeadroom = 0.0;
+}
+
+void CpuGovernor::setBudget(float fractionOfDeadline) noexcept
+{
+    budget = std::max(0.05f, std::min(fractionOfDeadline, 1.0f));
+}
+
+void CpuGovernor::setEnabled(bool shouldBeEnabled) noexcept
+{
+    if (shouldBeEnabled == enabled)
+        return;
+
+    enabled = shouldBeEnabled;
+    reset();
+}
+
+int CpuGovernor::update(double elapsedSeconds, int numSamples) noexcept
+{
+    if (! enabled || numSamples <= 0 || sampleRate <= 0.0)
+        return tier;
+
+    const double deadline = (double) numSamples / sampleRate;
+    const float blockLoad = (float) (elapsedSeconds / deadline);
+
+    // One-pole smoothing with a fixed time constant, whatever the block size
+    const float alpha = (float) (1.0 - std::exp(-deadline / loadTimeConstantSeconds));
+    load += alpha * (blockLoad - load);
+
+    secondsSinceChange += deadline;
+
+    const bool overBudget = load > budget || blockLoad >= 1.0f;
+    if (overBudget)
+    {
+        secondsWithHeadroom = 0.0;
+        if (tier < numTiers - 1 && secondsSinceChange >= stepDownDwellSeconds)
+        {
+            ++tier;
+            secondsSinceChange = 0.0;
+        }
+    }
+    else if (load < budget * stepUpRatio)
+    {
+        secondsWithHeadroom += deadline;
+        if (tier > tierFull && secondsWithHeadroom >= stepUpHoldSeconds)
+        {
+            --tier;
+            secondsSinceChange = 0.0;
+            secondsWithHeadroom = 0.0;
+        }
+    }
+    else
+    {
+        secondsWithHeadroom = 0.0;
+    }
+
+    return tier;
+}
@@ -0,0 +1,59 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+ * Chooses a processing tier from the measured cost of each block.
+ *
+ * The per-block load (processing time / block duration) is smoothed and
+ * compared against a budget. Over budget, or on any block that misses its
+ * deadline, the tier steps down after a short dwell; it only steps back up
+ * after the load has stayed well under the budget for a couple of seconds,
+ * so a tier that is just about affordable doesn't oscillate.
+ */
+class CpuGovernor
+{
+public:
+    enum Tier
+    {
+        tierFull = 0,        // everything as designed
+        tierCoarseControl,   // gain/bypass curves computed every few samples and interpolated
+        tierReducedSlopes,   // Low/High bands drop to a single biquad section
+        numTiers
+    };
+
+    void prepare(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    /** Budget as a fraction of the block deadline (e.g. 0.7). */
+    void setBudget(float fractionOfDeadline) noexcept;
+
+    /** Disabling returns to tierFull immediately. */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+
+    /** Feeds the cost of one block; returns the tier to use from the next block on. */
+    int update(double elapsedSeconds, int numSamples) noexcept;
+
+    int getTier() const noexcept { return tier; }
+    float getLoad() const noexcept { return load; }
+
+private:
+    static constexpr double loadTimeConstantSeconds = 0.05;
+    static constexpr double stepDownDwellSeconds = 0.1;
+    static constexpr double stepUpHoldSeconds = 2.0;
+    static constexpr float stepUpRatio = 0.6f; // load must fall below budget * ratio
+
+    double sampleRate = 44100.0;
+    float budget = 0.7f;
+    bool enabled = true;
+
+    int tier = tierFull;
+    float load = 0.0f;
+    double secondsSinceChange = 0.0;
+    double secondsWithHeadroom = 0.0;
+};
@@ -0,0 +1,417 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "DspKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if EQISOLATOR4_HAS_AVX_KERNELS
+ #if defined (_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace DspKernels
+{
+    namespace baselineKernels { extern const Table table; }
+   #if EQISOLATOR4_HAS_AVX_KERNELS
+    namespace avx2Kernels     { extern const Table table; }
+    namespace avx512Kernels   { extern const Table table; }
+   #endif
+
+namespace
+{
+    struct CpuFeatures
+    {
+        bool avx2 = false;   // AVX2 + FMA with YMM state enabled by the OS
+        bool avx512 = false; // AVX-512F + VL with ZMM state enabled by the OS
+    };
+
+   #if EQISOLATOR4_HAS_AVX_KERNELS
+    void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) noexcept
+    {
+       #if defined (_MSC_VER)
+        int r[4] = {};
+        __cpuidex(r, (int) leaf, (int) subleaf);
+        for (int i = 0; i < 4; ++i)
+            regs[i] = (unsigned int) r[i];
+       #else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+       #endif
+    }
+
+    unsigned long long readXcr0() noexcept
+    {
+       #if defined (_MSC_VER)
+        return _xgetbv(0);
+       #else
+        unsigned int lo = 0, hi = 0;
+        __asm__ volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        return ((unsigned long long) hi << 32) | lo;
+       #endif
+    }
+   #endif
+
+    CpuFeatures queryCpu() noexcept
+    {
+        CpuFeatures features;
+
+       #if EQISOLATOR4_HAS_AVX_KERNELS
+        unsigned int regs[4] = {};
+        cpuid(0, 0, regs);
+        const unsigned int maxLeaf = regs[0];
+        if (maxLeaf < 7)
+            return features;
+
+        cpuid(1, 0, regs);
+        const bool osxsave = (regs[2] & (1u << 27)) != 0;
+        const bool avx     = (regs[2] & (1u << 28)) != 0;
+        const bool fma     = (regs[2] & (1u << 12)) != 0;
+        if (! (osxsave && avx && fma))
+            return features;
+
+        // The CPU may have the units while the OS doesn't save their registers
+        const auto xcr0 = readXcr0();
+        const bool ymmState = (xcr0 & 0x6) == 0x6;
+        const bool zmmState = (xcr0 & 0xe6) == 0xe6;
+
+        cpuid(7, 0, regs);
+        const bool avx2     = (regs[1] & (1u << 5)) != 0;
+        const bool avx512f  = (regs[1] & (1u << 16)) != 0;
+        const bool avx512vl = (regs[1] & (1u << 31)) != 0;
+
+        features.avx2 = ymmState && avx2;
+        features.avx512 = features.avx2 && zmmState && avx512f && avx512vl;
+       #endif
+
+        return features;
+    }
+
+    const CpuFeatures& getCpuFeatures() noexcept
+    {
+        static const CpuFeatures features = queryCpu();
+        return features;
+    }
+
+    const Table* getTable(Level level) noexcept
+    {
+        switch (level)
+        {
+           #if EQISOLATOR4_HAS_AVX_KERNELS
+            case Level::avx512: return &avx512Kernels::table;
+            case Level::avx2:   return &avx2Kernels::table;
+           #endif
+            default:            return &baselineKernels::table;
+        }
+    }
+
+    bool environmentFlag(const char* name) noexcept
+    {
+        const char* value = std::getenv(name);
+        return value != nullptr && *value != '\0' && std::strcmp(value, "0") != 0;
+    }
+
+    // Deterministic pin > EQISOLATOR4_ISA override > best detected
+    Level chooseLevel() noexcept
+    {
+        if (environmentFlag("EQISOLATOR4_DETERMINISTIC"))
+            return Level::baseline;
+
+        if (const char* forced = std::getenv("EQISOLATOR4_ISA"))
+        {
+            for (int i = 0; i < (int) Level::numLevels; ++i)
+            {
+                const auto level = (Level) i;
+                if (std::strcmp(forced, getLevelName(level)) == 0 && isLevelAvailable(level))
+                    return level;
+            }
+        }
+
+        return detectBestLevel();
+    }
+
+    std::atomic<const Table*> currentTable { nullptr };
+}
+
+//==============================================================================
+Level detectBestLevel() noexcept
+{
+    const auto& features = getCpuFeatures();
+    if (features.avx512)
+        return Level::avx512;
+    if (features.avx2)
+        return Level::avx2;
+    return Level::baseline;
+}
+
+bool isLevelAvailable(Level level) noexcept
+{
+    return getTable(level)->level == level && (int) level <= (int) detectBestLevel();
+}
+
+const char* getLevelName(Level level) noexcept
+{
+    switch (level)
+    {
+        case Level::avx2:   return "avx2";
+        case Level::avx512: return "avx512";
+        default:            return "baseline";
+    }
+}
+
+const Table& get() noexcept
+{
+    auto* table = currentTable.load(std::memory_order_acquire);
+    if (table == nullptr)
+    {
+        // Every racing caller computes the same answer, so a plain store is fine
+        table = getTable(chooseLevel());
+        currentTable.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+void forceLevel(Level level) noexcept
+{
+    if (isLevelAvailable(level))
+        currentTable.store(getTable(level), std::memory_order_release);
+}
+
+void setDeterministic(bool shouldBeDeterministic) noexcept
+{
+    currentTable.store(getTable(shouldBeDeterministic ? Level::baseline : chooseLevel()), std::memory_order_release);
+}
+
+//==============================================================================
+void SplitState::setBand(int band, const float* section1, const float* section2) noexcept
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        const int lane = ch * bandsPerChannel + band;
+        for (int k = 0; k < 5; ++k)
+        {
+            coefficients[0][k][lane] = section1[k];
+            coefficients[1][k][lane] = section2[k];
+        }
+    }
+    blockFormsValid = false;
+}
+
+void SplitState::setDcBlocker(int band, float pole) noexcept
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        for (int b = 0; b < bandsPerChannel; ++b)
+        {
+            const int lane = ch * bandsPerChannel + b;
+            dcFeed[lane] = (b == band) ? 1.0f : 0.0f;
+            dcPole[lane] = (b == band) ? pole : 0.0f;
+        }
+    }
+    blockFormsValid = false;
+}
+
+void SplitState::setSlopeBand(int band, bool followsBlend) noexcept
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+        slopeLane[ch * bandsPerChannel + band] = followsBlend ? 1.0f : 0.0f;
+    blockFormsValid = false;
+}
+
+void SplitState::clearSlopeSections() noexcept
+{
+    for (int lane = 0; lane < maxLanes; ++lane)
+    {
+        if (slopeLane[lane] != 0.0f)
+            z1[1][lane] = z2[1][lane] = 0.0f;
+    }
+}
+
+void SplitState::clearLowerBands() noexcept
+{
+    for (int lane = 0; lane < maxLanes; ++lane)
+    {
+        if (lane % bandsPerChannel < bandsPerChannel / 2)
+        {
+            z1[0][lane] = z1[1][lane] = 0.0f;
+            z2[0][lane] = z2[1][lane] = 0.0f;
+            dcPrevX[lane] = dcPrevY[lane] = 0.0f;
+        }
+    }
+}
+
+void SplitState::updateBlockForms(float slopeBlend) noexcept
+{
+    // Every column is the response of the sample-by-sample chain to a unit
+    // state or input, run in double so the forms are exact to float precision
+    for (int band = 0; band < bandsPerChannel; ++band)
+    {
+        double c[2][5];
+        for (int s = 0; s < 2; ++s)
+            for (int k = 0; k < 5; ++k)
+                c[s][k] = (double) coefficients[s][k][band];
+
+        const double weight = 1.0 - (double) slopeLane[band] * (1.0 - (double) slopeBlend);
+        const double feed = (double) dcFeed[band];
+        const double pole = (double) dcPole[band];
+
+        auto step = [&](double (&s)[blockStates], double x) noexcept
+        {
+            const double y1 = c[0][0] * x + s[0];
+            s[0] = c[0][1] * x - c[0][3] * y1 + s[1];
+            s[1] = c[0][2] * x - c[0][4] * y1;
+
+            const double y2 = c[1][0] * y1 + s[2];
+            s[2] = c[1][1] * y1 - c[1][3] * y2 + s[3];
+            s[3] = c[1][2] * y1 - c[1][4] * y2;
+
+            const double y = weight * y2 + (1.0 - weight) * y1;
+            const double out = y - feed * s[4] + pole * s[5];
+            s[4] = y;
+            s[5] = out;
+            return out;
+        };
+
+        auto& form = blockForms[band];
+        std::memset(&form, 0, sizeof(form));
+
+        // Zero input, unit state j: output row and state transition
+        for (int j = 0; j < blockStates; ++j)
+        {
+            double s[blockStates] = {};
+            s[j] = 1.0;
+            for (int i = 0; i < blockLength; ++i)
+                form.output[j][i] = (float) step(s, 0.0);
+            for (int k = 0; k < blockStates; ++k)
+                form.advance[j][k] = (float) s[k];
+        }
+
+        // Zero state, unit impulse at m: shifted impulse response and the state it leaves
+        double response[blockLength];
+        double leftState[blockLength][blockStates];
+        {
+            double s[blockStates] = {};
+            for (int i = 0; i < blockLength; ++i)
+            {
+                response[i] = step(s, i == 0 ? 1.0 : 0.0);
+                for (int k = 0; k < blockStates; ++k)
+                    leftState[i][k] = s[k];
+            }
+        }
+
+        for (int m = 0; m < blockLength; ++m)
+        {
+            for (int i = m; i < blockLength; ++i)
+                form.impulse[m][i] = (float) response[i - m];
+            for (int k = 0; k < blockStates; ++k)
+                form.inject[m][k] = (float) leftState[blockLength - 1 - m][k];
+        }
+    }
+
+    blockFormBlend = slopeBlend;
+    blockFormsValid = true;
+}
+
+float SplitState::getChannelStateDifference() const noexcept
+{
+    float largest = 0.0f;
+    for (int lane = 0; lane < bandsPerChannel; ++lane)
+    {
+        const int other = lane + bandsPerChannel;
+
+        // A skipped section's state is stale and cleared before it is used again
+        const bool sectionTwoLive = ! (skipSlopeSections && slopeLane[lane] != 0.0f);
+        const float differences[] = { z1[0][lane] - z1[0][other], z2[0][lane] - z2[0][other],
+                                      sectionTwoLive ? z1[1][lane] - z1[1][other] : 0.0f,
+                                      sectionTwoLive ? z2[1][lane] - z2[1][other] : 0.0f,
+                                      dcPrevX[lane] - dcPrevX[other], dcPrevY[lane] - dcPrevY[other] };
+        for (float difference : differences)
+            largest = std::max(largest, std::abs(difference));
+    }
+    return largest;
+}
+
+void SplitState::copyFirstChannelState() noexcept
+{
+    for (int lane = 0; lane < bandsPerChannel; ++lane)
+    {
+        const int other = lane + bandsPerChannel;
+        for (int s = 0; s < 2; ++s)
+        {
+            z1[s][other] = z1[s][lane];
+            z2[s][other] = z2[s][lane];
+        }
+        dcPrevX[other] = dcPrevX[lane];
+        dcPrevY[other] = dcPrevY[lane];
+    }
+}
+
+void SplitState::encodeMidSideState() noexcept
+{
+    auto encode = [](float& left, float& right) noexcept
+    {
+        const float mid = 0.5f * (left + right);
+        right = 0.5f * (left - right);
+        left = mid;
+    };
+
+    for (int lane = 0; lane < bandsPerChannel; ++lane)
+    {
+        const int other = lane + bandsPerChannel;
+        for (int s = 0; s < 2; ++s)
+        {
+            encode(z1[s][lane], z1[s][other]);
+            encode(z2[s][lane], z2[s][other]);
+        }
+        encode(dcPrevX[lane], dcPrevX[other]);
+        encode(dcPrevY[lane], dcPrevY[other]);
+    }
+}
+
+void SplitState::decodeMidSideState() noexcept
+{
+    auto decode = [](float& mid, float& side) noexcept
+    {
+        const float left = mid + side;
+        side = mid - side;
+        mid = left;
+    };
+
+    for (int lane = 0; lane < bandsPerChannel; ++lane)
+    {
+        const int other = lane + bandsPerChannel;
+        for (int s = 0; s < 2; ++s)
+        {
+            decode(z1[s][lane], z1[s][other]);
+            decode(z2[s][lane], z2[s][other]);
+        }
+        decode(dcPrevX[lane], dcPrevX[other]);
+        decode(dcPrevY[lane], dcPrevY[other]);
+    }
+}
+
+void SplitState::reset() noexcept
+{
+    for (int lane = 0; lane < maxLanes; ++lane)
+    {
+        z1[0][lane] = z1[1][lane] = 0.0f;
+        z2[0][lane] = z2[1][lane] = 0.0f;
+        dcPrevX[lane] = dcPrevY[lane] = 0.0f;
+    }
+}
+
+void DynamicsState::reset() noexcept
+{
+    for (int lane = 0; lane < lanes; ++lane)
+        gainChange[lane] = 0.0f;
+}
+}
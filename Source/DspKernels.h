@@ -0,0 +1,231 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <cstddef>
+
+//==============================================================================
+/**
+ * Hot DSP kernels compiled once per instruction-set level and selected at
+ * runtime from CPUID.
+ *
+ * Every level runs the same source (DspKernelsImpl.h) built with different
+ * target flags, so the choice affects speed and, through FMA contraction and
+ * vector width, the last bits of the result. For bit-identical renders across
+ * machines, pin one level with setDeterministic(true) or the environment
+ * variable EQISOLATOR4_DETERMINISTIC=1. For testing, force a level with
+ * forceLevel() or EQISOLATOR4_ISA=baseline|avx2|avx512.
+ *
+ * No JUCE here: the kernel translation units must not instantiate any shared
+ * inline code, or the linker could hand an AVX copy to baseline callers.
+ */
+namespace DspKernels
+{
+    enum class Level
+    {
+        baseline = 0, // SSE2 on x86-64, NEON on AArch64
+        avx2,         // AVX2 + FMA
+        avx512,       // AVX-512F/VL
+        numLevels
+    };
+
+    //==============================================================================
+    /**
+     * State of the four-band split for up to two channels. Each (channel, band)
+     * pair is a lane: two cascaded biquads (TDF-II) plus a first-order DC
+     * blocker, all lanes advanced together one sample at a time.
+     * Lane index = channel * 4 + band.
+     */
+    struct SplitState
+    {
+        static constexpr int bandsPerChannel = 4;
+        static constexpr int maxChannels = 2;
+        static constexpr int maxLanes = bandsPerChannel * maxChannels;
+
+        alignas(64) float coefficients[2][5][maxLanes] {}; // [section][b0 b1 b2 a1 a2][lane]
+        alignas(64) float z1[2][maxLanes] {};               // [section][lane]
+        alignas(64) float z2[2][maxLanes] {};
+        alignas(64) float slopeLane[maxLanes] {};           // 1: section 2 follows the slope blend
+        alignas(64) float dcFeed[maxLanes] {};              // 1 on DC-blocked lanes, 0 = pass-through
+        alignas(64) float dcPole[maxLanes] {};
+        alignas(64) float dcPrevX[maxLanes] {};
+        alignas(64) float dcPrevY[maxLanes] {};
+
+        // Interleaved scratch (scratchFrames * maxLanes floats), owned by the caller
+        float* scratch = nullptr;
+        int scratchFrames = 0;
+
+        /**
+         * Block form of one band's whole chain (both sections, slope weight, DC
+         * blocker) at a constant slope blend, advancing blockLength samples per
+         * step: with the lane state s = (z1, z2 of section 1, z1, z2 of section 2,
+         * DC prevX, prevY) and the inputs x of the block,
+         *   y[i]  = sum_j s[j] * output[j][i]  + sum_m x[m] * impulse[m][i]
+         *   s'[k] = sum_j s[j] * advance[j][k] + sum_m x[m] * inject[m][k]
+         * Both channels share a band's form. Derived from the coefficients on
+         * first use after a change (updateBlockForms).
+         */
+        static constexpr int blockLength = 8;
+        static constexpr int blockStates = 6;
+        static constexpr int blockStatesPadded = 8; // one vector
+
+        struct BlockForm
+        {
+            alignas(32) float output[blockStates][blockLength];
+            alignas(32) float impulse[blockLength][blockLength]; // zero above the diagonal (m > i)
+            alignas(32) float advance[blockStates][blockStatesPadded];
+            alignas(32) float inject[blockLength][blockStatesPadded];
+        };
+
+        BlockForm blockForms[bandsPerChannel];
+        float blockFormBlend = 1.0f;
+        bool blockFormsValid = false;
+
+        void updateBlockForms(float slopeBlend) noexcept;
+
+        /** Raw normalised coefficients (b0 b1 b2 a1 a2) of both sections of a band, for every channel. */
+        void setBand(int band, const float* section1, const float* section2) noexcept;
+
+        /** First-order DC blocker on one band (pole r); other bands pass through. */
+        void setDcBlocker(int band, float pole) noexcept;
+
+        /** Bands whose second section is crossfaded by the governor's slope blend. */
+        void setSlopeBand(int band, bool followsBlend) noexcept;
+
+        /**
+         * Set by the owner while the slope blend is settled at 0: the slope lanes
+         * then run their first section only. Their second-section state goes stale;
+         * clear it (clearSlopeSections) and let it run again before the blend moves.
+         */
+        bool skipSlopeSections = false;
+
+        void clearSlopeSections() noexcept;
+
+        /**
+         * Set by the owner while it fills the Low and Low-Mid bands itself (the
+         * multirate low branch): only the upper half of each channel's bands is
+         * split. The lower outputs are left alone and their lanes stand still;
+         * clear them (clearLowerBands) whenever the flag changes.
+         */
+        bool upperBandsOnly = false;
+
+        void clearLowerBands() noexcept;
+
+        /** Largest difference between the second channel's lane state and the first's. */
+        float getChannelStateDifference() const noexcept;
+
+        /** Gives the second channel the first one's state, after a block split once for both. */
+        void copyFirstChannelState() noexcept;
+
+        /**
+         * Rewrites the pair's state for inputs switching between left/right and
+         * mid/side ((L + R) / 2, (L - R) / 2). The lanes are linear, so the
+         * converted state is the one the other inputs would have left: the split
+         * carries on across the switch without a transient.
+         */
+        void encodeMidSideState() noexcept;
+        void decodeMidSideState() noexcept;
+
+        void reset() noexcept;
+    };
+
+    //==============================================================================
+    /**
+     * Per-band dynamics (compressor / expander / gate) with linked detection,
+     * one lane per band so the four detectors run side by side. Levels and gain
+     * changes are in log2 units (1 = 6.02 dB); the static curve is
+     *   change = max(floor, slopeAbove * max(level - threshold, 0)
+     *                       - slopeBelow * max(threshold - level, 0))
+     * smoothed by a one-pole with separate coefficients for a falling and a
+     * rising gain. An idle lane (slopes and floor 0) settles on exactly unity gain.
+     */
+    struct DynamicsState
+    {
+        static constexpr int lanes = SplitState::bandsPerChannel;
+
+        alignas(16) float threshold[lanes] {};         // log2 of the linear threshold
+        alignas(16) float slopeAbove[lanes] {};        // compressor: 1 / ratio - 1, else 0
+        alignas(16) float slopeBelow[lanes] {};        // expander: ratio - 1, gate: steep, else 0
+        alignas(16) float floor[lanes] {};             // deepest gain change (<= 0, above -126)
+        alignas(16) float fallCoefficient[lanes] {};   // one-pole: compressor attack, expander/gate release
+        alignas(16) float riseCoefficient[lanes] {};   // compressor release, expander/gate attack
+        alignas(16) float gainChange[lanes] {};        // smoothed, log2 units, <= 0
+
+        void reset() noexcept;
+    };
+
+    //==============================================================================
+    struct Table
+    {
+        const char* name;
+        Level level;
+
+        /**
+         * Splits numChannels (1 or 2) inputs into bandOutputs[band][channel].
+         * slopeBlend (per sample, may be null -> slopeBlendConstant) crossfades the
+         * second section of the slope lanes: 1 = full order, 0 = single section
+         * (not run at all once settled there with state.skipSlopeSections set).
+         * With state.upperBandsOnly only bandOutputs[2] and [3] are written.
+         * Outputs may alias the inputs. Results may differ in the last bits between
+         * levels, but not between mono and stereo: a channel split alone gives the
+         * same bits as in a pair (the dual-mono link in IsolatorCore relies on it).
+         */
+        void (*splitBands)(SplitState& state, const float* const* inputs, int numChannels,
+                           float* const* const* bandOutputs, int numSamples,
+                           const float* slopeBlend, float slopeBlendConstant);
+
+        /** output = sum over 4 bands of band * gain * bypass. */
+        void (*mixBands)(float* output, const float* const* bands, const float* const* gains,
+                         const float* const* bypasses, int numSamples);
+
+        /**
+         * Mid/side decode fused into the mix, for one channel pair:
+         *   mid = sum of midBands * gains * bypasses, side = the same over the side set,
+         *   left = mid + side, right = mid - side.
+         */
+        void (*mixBandsMidSide)(float* left, float* right,
+                                const float* const* midBands, const float* const* midGains, const float* const* midBypasses,
+                                const float* const* sideBands, const float* const* sideGains, const float* const* sideBypasses,
+                                int numSamples);
+
+        /** data *= gain * bypass */
+        void (*applyGain)(float* data, const float* gain, const float* bypass, int numSamples);
+
+        /** peak = |input| (accumulate == false) or max(peak, |input|) */
+        void (*absMax)(float* peak, const float* input, int numSamples, bool accumulate);
+
+        /**
+         * Moving average by running sum: per sample, sum += data - leaving (the value
+         * dropping out of the window), then data = sum * scale. In place; sum carries
+         * across calls and is accumulated in double.
+         */
+        void (*boxFilter)(float* data, const float* leaving, int numSamples, double* sum, double scale);
+
+        /**
+         * gains[band] *= dynamics gain from detectors[band] (linked peak levels), 4 bands,
+         * and sideGains[band] too unless sideGains is null (mid/side: one detector, both curves).
+         * The detector buffers are used as scratch and overwritten.
+         */
+        void (*bandDynamics)(DynamicsState& state, float* const* detectors, float* const* gains,
+                             float* const* sideGains, int numSamples);
+    };
+
+    /** The table in use; selected on first call (CPUID, then overrides). */
+    const Table& get() noexcept;
+
+    /** Best level this CPU and OS support (ignores overrides). */
+    Level detectBestLevel() noexcept;
+
+    bool isLevelAvailable(Level level) noexcept;
+    const char* getLevelName(Level level) noexcept;
+
+    /** Testing override; ignored if the level isn't available. Call before processing starts. */
+    void forceLevel(Level level) noexcept;
+
+    /** Pins the baseline level so renders are bit-identical on every machine. */
+    void setDeterministic(bool shouldBeDeterministic) noexcept;
+}
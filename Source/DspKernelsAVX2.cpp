@@ -0,0 +1,17 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// AVX2 + FMA kernels. Built with -mavx2 -mfma (/arch:AVX2) on x86 only; only
+// ever called after DspKernels has checked CPUID and the OS-saved YMM state.
+
+#if EQISOLATOR4_HAS_AVX_KERNELS
+
+#define EQ4_KERNEL_NAME "AVX2"
+#define EQ4_KERNEL_NAMESPACE avx2Kernels
+#define EQ4_KERNEL_LEVEL Level::avx2
+#include "DspKernelsImpl.h"
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// AVX-512F/VL kernels. Built with -mavx512f -mavx512vl (/arch:AVX512) on x86
+// only; only ever called after DspKernels has checked CPUID and the OS-saved
+// ZMM state. The eight stereo lanes still fit one YMM register, so the gain
+// over AVX2 comes from the masked tails of the gain and mix loops.
+
+#if EQISOLATOR4_HAS_AVX_KERNELS
+
+#define EQ4_KERNEL_NAME "AVX-512"
+#define EQ4_KERNEL_NAMESPACE avx512Kernels
+#define EQ4_KERNEL_LEVEL Level::avx512
+#include "DspKernelsImpl.h"
+
+#endif
@@ -0,0 +1,20 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Baseline kernels: the architecture's guaranteed vector unit, no extra flags.
+// Also the level pinned by deterministic mode.
+
+#if defined (__aarch64__) || defined (_M_ARM64)
+ #define EQ4_KERNEL_NAME "NEON"
+#elif defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define EQ4_KERNEL_NAME "SSE2"
+#else
+ #define EQ4_KERNEL_NAME "scalar"
+#endif
+
+#define EQ4_KERNEL_NAMESPACE baselineKernels
+#define EQ4_KERNEL_LEVEL Level::baseline
+#include "DspKernelsImpl.h"
@@ -0,0 +1,759 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Kernel bodies, included once per instruction-set translation unit with
+// EQ4_KERNEL_NAMESPACE, EQ4_KERNEL_NAME and EQ4_KERNEL_LEVEL defined. Plain loops over fixed
+// lane counts that the compiler vectorises for the TU's target flags.
+//
+// Deliberately self-contained: no std:: or JUCE templates, whose inline copies
+// compiled with AVX flags could be picked by the linker for every caller.
+
+#if ! defined (EQ4_KERNEL_NAMESPACE) || ! defined (EQ4_KERNEL_NAME) || ! defined (EQ4_KERNEL_LEVEL)
+ #error "Define EQ4_KERNEL_NAMESPACE, EQ4_KERNEL_NAME and EQ4_KERNEL_LEVEL before including DspKernelsImpl.h"
+#endif
+
+#include "DspKernels.h"
+
+#if defined (_MSC_VER)
+ #include <string.h>
+ #define EQ4_RESTRICT __restrict
+ #define EQ4_BIT_COPY memcpy
+#else
+ #define EQ4_RESTRICT __restrict__
+ #define EQ4_BIT_COPY __builtin_memcpy
+#endif
+
+namespace DspKernels
+{
+namespace EQ4_KERNEL_NAMESPACE
+{
+namespace
+{
+    inline float absolute(float x) noexcept   { return x < 0.0f ? -x : x; }
+    inline float maximum(float a, float b) noexcept { return a < b ? b : a; }
+    inline int minimum(int a, int b) noexcept  { return a < b ? a : b; }
+
+    // Branch-free helpers for the time-vectorised dynamics passes (ternaries keep GCC at -O2 from vectorising)
+    inline float magnitude(float x) noexcept
+    {
+        int bits;
+        EQ4_BIT_COPY(&bits, &x, sizeof(bits));
+        bits &= 0x7fffffff;
+        EQ4_BIT_COPY(&x, &bits, sizeof(x));
+        return x;
+    }
+
+    inline float larger(float a, float b) noexcept { return 0.5f * (a + b + magnitude(a - b)); }
+
+    // log2 / exp2 for the dynamics: polynomial on the mantissa, < 0.001 dB error.
+    // Bit casts are plain copies, which the compiler keeps in (vector) registers.
+    inline float fastLog2(float x) noexcept // x > 0
+    {
+        int bits;
+        EQ4_BIT_COPY(&bits, &x, sizeof(bits));
+        const float exponent = (float) (((bits >> 23) & 255) - 127);
+        bits = (bits & 0x007fffff) | 0x3f800000;
+        float m;
+        EQ4_BIT_COPY(&m, &bits, sizeof(m));
+        const float t = m - 1.0f;
+        return exponent + t * (1.4418255f + t * (-0.70867891f + t * (0.41541119f + t * (-0.19440832f + t * 0.045878950f))));
+    }
+
+    inline float fastExp2(float x) noexcept // -126 < x < 1; exp2(0) is exactly 1
+    {
+        const int whole = (int) (x + 128.0f) - 128; // floor, truncating a positive value
+        const float f = x - (float) whole;
+        const int bits = (whole + 127) << 23;
+        float scale;
+        EQ4_BIT_COPY(&scale, &bits, sizeof(scale));
+        return scale * (1.0f + f * (0.69315275f + f * (0.24015316f + f * (0.055828290f + f * (0.0089888128f + f * 0.0018767084f)))));
+    }
+
+    //==============================================================================
+    // All lanes advance one sample per step: section 1 -> section 2 -> optional
+    // slope crossfade -> DC blocker, the whole frame kept interleaved in scratch.
+    // Blend == false is the plain full-order path (bit-exact, no crossfade maths).
+    // Upper runs only the upper half of each channel's bands (SplitState::upperBandsOnly),
+    // packed together: position p is then lane (p / 2) * 4 + 2 + p % 2.
+    template <int Lanes, bool Blend, bool Upper = false>
+    void splitLanes(SplitState& state, const float* const* inputs, int numChannels,
+                    float* const* const* bandOutputs, int numSamples,
+                    const float* slopeBlend, float slopeBlendConstant) noexcept
+    {
+        constexpr int bands = SplitState::bandsPerChannel;
+        constexpr int perChannel = Upper ? bands / 2 : bands;
+        constexpr int firstBand = bands - perChannel;
+
+        float c[2][5][Lanes], s1[2][Lanes], s2[2][Lanes];
+        float slope[Lanes], feed[Lanes], pole[Lanes], prevX[Lanes], prevY[Lanes];
+
+        for (int p = 0; p < Lanes; ++p)
+        {
+            const int l = (p / perChannel) * bands + firstBand + p % perChannel;
+            for (int s = 0; s < 2; ++s)
+            {
+                for (int k = 0; k < 5; ++k)
+                    c[s][k][p] = state.coefficients[s][k][l];
+                s1[s][p] = state.z1[s][l];
+                s2[s][p] = state.z2[s][l];
+            }
+            slope[p] = state.slopeLane[l];
+            feed[p] = state.dcFeed[l];
+            pole[p] = state.dcPole[l];
+            prevX[p] = state.dcPrevX[l];
+            prevY[p] = state.dcPrevY[l];
+        }
+
+        float* const EQ4_RESTRICT frames = state.scratch;
+        const int chunk = state.scratchFrames;
+
+        for (int start = 0; start < numSamples; start += chunk)
+        {
+            const int n = minimum(chunk, numSamples - start);
+
+            for (int i = 0; i < n; ++i)
+            {
+                float x[Lanes];
+                for (int ch = 0; ch < Lanes / perChannel; ++ch)
+                {
+                    const float sample = inputs[ch < numChannels ? ch : 0][start + i];
+                    for (int b = 0; b < perChannel; ++b)
+                        x[ch * perChannel + b] = sample;
+                }
+
+                const float blend = slopeBlend != nullptr ? slopeBlend[start + i] : slopeBlendConstant;
+                float* const EQ4_RESTRICT frame = frames + i * Lanes;
+
+                for (int l = 0; l < Lanes; ++l)
+                {
+                    // Transposed direct form II, as juce::dsp::IIR::Filter
+                    const float y1 = c[0][0][l] * x[l] + s1[0][l];
+                    s1[0][l] = c[0][1][l] * x[l] - c[0][3][l] * y1 + s2[0][l];
+                    s2[0][l] = c[0][2][l] * x[l] - c[0][4][l] * y1;
+
+                    const float y2 = c[1][0][l] * y1 + s1[1][l];
+                    s1[1][l] = c[1][1][l] * y1 - c[1][3][l] * y2 + s2[1][l];
+                    s2[1][l] = c[1][2][l] * y1 - c[1][4][l] * y2;
+
+                    // Exact at either end, so a settled lane gives the same bits as without the blend
+                    float y = y2;
+                    if (Blend)
+                    {
+                        const float weight = 1.0f - slope[l] * (1.0f - blend);
+                        y = weight * y2 + (1.0f - weight) * y1;
+                    }
+
+                    // H(z) = (1 - z^-1) / (1 - r z^-1) on DC lanes, identity elsewhere
+                    const float out = y - feed[l] * prevX[l] + pole[l] * prevY[l];
+                    prevX[l] = y;
+                    prevY[l] = out;
+                    frame[l] = out;
+                }
+            }
+
+            // De-interleave after the whole chunk is read, so outputs may alias inputs
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                for (int b = 0; b < perChannel; ++b)
+                {
+                    const int p = ch * perChannel + b;
+                    float* const EQ4_RESTRICT out = bandOutputs[firstBand + b][ch] + start;
+                    for (int i = 0; i < n; ++i)
+                        out[i] = frames[i * Lanes + p];
+                }
+            }
+        }
+
+        for (int p = 0; p < Lanes; ++p)
+        {
+            const int l = (p / perChannel) * bands + firstBand + p % perChannel;
+            for (int s = 0; s < 2; ++s)
+            {
+                state.z1[s][l] = s1[s][p];
+                state.z2[s][l] = s2[s][p];
+            }
+            state.dcPrevX[l] = prevX[p];
+            state.dcPrevY[l] = prevY[p];
+        }
+    }
+
+    //==============================================================================
+    // Slope blend settled at 0 with skipSlopeSections set: the slope lanes stop after
+    // section 1. The lanes are reordered so the ones that keep their second section
+    // come first (channel by channel), and section 2 only runs on that half. Needs
+    // half the bands of each channel to be slope bands; returns false otherwise.
+    template <int Lanes>
+    bool splitLanesSingle(SplitState& state, const float* const* inputs, int numChannels,
+                          float* const* const* bandOutputs, int numSamples) noexcept
+    {
+        constexpr int bands = SplitState::bandsPerChannel;
+        constexpr int half = Lanes / 2;
+
+        int order[Lanes];
+        for (int ch = 0; ch < Lanes / bands; ++ch)
+        {
+            int kept = 0, single = 0;
+            for (int b = 0; b < bands; ++b)
+            {
+                const int lane = ch * bands + b;
+                const bool slope = state.slopeLane[lane] != 0.0f;
+                if ((slope ? single : kept) == bands / 2)
+                    return false;
+                order[slope ? half + ch * (bands / 2) + single++ : ch * (bands / 2) + kept++] = lane;
+            }
+        }
+
+        float c[2][5][Lanes], s1[2][Lanes], s2[2][Lanes];
+        float feed[Lanes], pole[Lanes], prevX[Lanes], prevY[Lanes];
+
+        for (int p = 0; p < Lanes; ++p)
+        {
+            const int l = order[p];
+            for (int s = 0; s < 2; ++s)
+            {
+                for (int k = 0; k < 5; ++k)
+                    c[s][k][p] = state.coefficients[s][k][l];
+                s1[s][p] = state.z1[s][l];
+                s2[s][p] = state.z2[s][l];
+            }
+            feed[p] = state.dcFeed[l];
+            pole[p] = state.dcPole[l];
+            prevX[p] = state.dcPrevX[l];
+            prevY[p] = state.dcPrevY[l];
+        }
+
+        float* const EQ4_RESTRICT frames = state.scratch;
+        const int chunk = state.scratchFrames;
+
+        for (int start = 0; start < numSamples; start += chunk)
+        {
+            const int n = minimum(chunk, numSamples - start);
+
+            for (int i = 0; i < n; ++i)
+            {
+                float x[Lanes];
+                for (int ch = 0; ch < Lanes / bands; ++ch)
+                {
+                    const float sample = inputs[ch < numChannels ? ch : 0][start + i];
+                    for (int k = 0; k < bands / 2; ++k)
+                        x[ch * (bands / 2) + k] = x[half + ch * (bands / 2) + k] = sample;
+                }
+
+                float* const EQ4_RESTRICT frame = frames + i * Lanes;
+
+                // Same chain as splitLanes, without the crossfade
+                for (int p = 0; p < half; ++p)
+                {
+                    const float y1 = c[0][0][p] * x[p] + s1[0][p];
+                    s1[0][p] = c[0][1][p] * x[p] - c[0][3][p] * y1 + s2[0][p];
+                    s2[0][p] = c[0][2][p] * x[p] - c[0][4][p] * y1;
+
+                    const float y2 = c[1][0][p] * y1 + s1[1][p];
+                    s1[1][p] = c[1][1][p] * y1 - c[1][3][p] * y2 + s2[1][p];
+                    s2[1][p] = c[1][2][p] * y1 - c[1][4][p] * y2;
+
+                    const float out = y2 - feed[p] * prevX[p] + pole[p] * prevY[p];
+                    prevX[p] = y2;
+                    prevY[p] = out;
+                    frame[p] = out;
+                }
+
+                for (int p = half; p < Lanes; ++p)
+                {
+                    const float y1 = c[0][0][p] * x[p] + s1[0][p];
+                    s1[0][p] = c[0][1][p] * x[p] - c[0][3][p] * y1 + s2[0][p];
+                    s2[0][p] = c[0][2][p] * x[p] - c[0][4][p] * y1;
+
+                    const float out = y1 - feed[p] * prevX[p] + pole[p] * prevY[p];
+                    prevX[p] = y1;
+                    prevY[p] = out;
+                    frame[p] = out;
+                }
+            }
+
+            for (int p = 0; p < Lanes; ++p)
+            {
+                const int lane = order[p];
+                if (lane / bands >= numChannels)
+                    continue;
+
+                float* const EQ4_RESTRICT out = bandOutputs[lane % bands][lane / bands] + start;
+                for (int i = 0; i < n; ++i)
+                    out[i] = frames[i * Lanes + p];
+            }
+        }
+
+        for (int p = 0; p < Lanes; ++p)
+        {
+            const int l = order[p];
+            state.z1[0][l] = s1[0][p];
+            state.z2[0][l] = s2[0][p];
+            if (p < half)
+            {
+                state.z1[1][l] = s1[1][p];
+                state.z2[1][l] = s2[1][p];
+            }
+            state.dcPrevX[l] = prevX[p];
+            state.dcPrevY[l] = prevY[p];
+        }
+
+        return true;
+    }
+
+    template <int Lanes>
+    void splitLanes(SplitState& state, const float* const* inputs, int numChannels,
+                    float* const* const* bandOutputs, int numSamples,
+                    const float* slopeBlend, float slopeBlendConstant) noexcept
+    {
+        constexpr int upperLanes = Lanes / 2;
+        const bool fullOrder = slopeBlend == nullptr && slopeBlendConstant == 1.0f;
+
+        // High is the only slope lane left, so the single-section reordering has nothing to pair
+        if (state.upperBandsOnly)
+        {
+            if (fullOrder)
+                splitLanes<upperLanes, false, true>(state, inputs, numChannels, bandOutputs, numSamples, nullptr, 1.0f);
+            else
+                splitLanes<upperLanes, true, true>(state, inputs, numChannels, bandOutputs, numSamples, slopeBlend, slopeBlendConstant);
+            return;
+        }
+
+        if (fullOrder)
+        {
+            splitLanes<Lanes, false>(state, inputs, numChannels, bandOutputs, numSamples, nullptr, 1.0f);
+            return;
+        }
+
+        // Only pays where each half still fills a vector: stereo on the 4-wide baseline
+        constexpr bool singlePays = Lanes == SplitState::maxLanes && EQ4_KERNEL_LEVEL == Level::baseline;
+        if (singlePays && slopeBlend == nullptr && slopeBlendConstant == 0.0f && state.skipSlopeSections
+             && splitLanesSingle<Lanes>(state, inputs, numChannels, bandOutputs, numSamples))
+            return;
+
+        splitLanes<Lanes, true>(state, inputs, numChannels, bandOutputs, numSamples, slopeBlend, slopeBlendConstant);
+    }
+
+    //==============================================================================
+    // One block step of a band: y = its outputs, lane = its state, advanced in place.
+    // Written out so each sum stays in registers; the input terms come first, keeping
+    // the block-to-block dependency on the state short. SingleSection drops the
+    // section 2 terms, which a slope band's form zeroes at blend 0 (that state is
+    // left stale, see SplitState::skipSlopeSections).
+    template <bool SingleSection>
+    inline void stepBlock(const SplitState::BlockForm& form, const float* x, float* lane, float* y) noexcept
+    {
+        constexpr int length = SplitState::blockLength;
+        constexpr int padded = SplitState::blockStatesPadded;
+
+        for (int i = 0; i < length; ++i)
+        {
+            const float driven = x[0] * form.impulse[0][i] + x[1] * form.impulse[1][i]
+                               + x[2] * form.impulse[2][i] + x[3] * form.impulse[3][i]
+                               + x[4] * form.impulse[4][i] + x[5] * form.impulse[5][i]
+                               + x[6] * form.impulse[6][i] + x[7] * form.impulse[7][i];
+            if (SingleSection)
+                y[i] = driven + (lane[0] * form.output[0][i] + lane[1] * form.output[1][i]
+                               + lane[4] * form.output[4][i] + lane[5] * form.output[5][i]);
+            else
+                y[i] = driven + (lane[0] * form.output[0][i] + lane[1] * form.output[1][i]
+                               + lane[2] * form.output[2][i] + lane[3] * form.output[3][i]
+                               + lane[4] * form.output[4][i] + lane[5] * form.output[5][i]);
+        }
+
+        float next[padded];
+        for (int k = 0; k < padded; ++k)
+        {
+            const float driven = x[0] * form.inject[0][k] + x[1] * form.inject[1][k]
+                               + x[2] * form.inject[2][k] + x[3] * form.inject[3][k]
+                               + x[4] * form.inject[4][k] + x[5] * form.inject[5][k]
+                               + x[6] * form.inject[6][k] + x[7] * form.inject[7][k];
+            if (SingleSection)
+                next[k] = driven + (lane[0] * form.advance[0][k] + lane[1] * form.advance[1][k]
+                                  + lane[4] * form.advance[4][k] + lane[5] * form.advance[5][k]);
+            else
+                next[k] = driven + (lane[0] * form.advance[0][k] + lane[1] * form.advance[1][k]
+                                  + lane[2] * form.advance[2][k] + lane[3] * form.advance[3][k]
+                                  + lane[4] * form.advance[4][k] + lane[5] * form.advance[5][k]);
+        }
+
+        for (int k = 0; k < padded; ++k)
+            lane[k] = next[k];
+    }
+
+    //==============================================================================
+    // Time-vectorised split: each band advances a whole block of consecutive samples
+    // per step through its block form, so mono and stereo fill the vector with time
+    // instead of leaving lanes empty, and the per-sample recursion disappears.
+    // Constant slope blend only; a partial block at the end runs on the lanes.
+    // One body for mono and stereo, so a channel's bits don't depend on its partner.
+    void splitBlocks(SplitState& state, const float* const* inputs, int numChannels,
+                     float* const* const* bandOutputs, int numSamples, float slopeBlendConstant) noexcept
+    {
+        constexpr int bands = SplitState::bandsPerChannel;
+        constexpr int lanes = SplitState::maxLanes;
+        constexpr int length = SplitState::blockLength;
+        constexpr int states = SplitState::blockStates;
+        constexpr int padded = SplitState::blockStatesPadded;
+        static_assert(length == 8 && states == 6, "the block sums below are written out for 8 samples and 6 states");
+
+        if (! state.blockFormsValid || state.blockFormBlend != slopeBlendConstant)
+            state.updateBlockForms(slopeBlendConstant);
+
+        const bool single = state.skipSlopeSections && slopeBlendConstant == 0.0f;
+        const int firstBand = state.upperBandsOnly ? bands / 2 : 0;
+
+        float s[lanes][padded];
+        for (int l = 0; l < lanes; ++l)
+        {
+            s[l][0] = state.z1[0][l];
+            s[l][1] = state.z2[0][l];
+            s[l][2] = state.z1[1][l];
+            s[l][3] = state.z2[1][l];
+            s[l][4] = state.dcPrevX[l];
+            s[l][5] = state.dcPrevY[l];
+            s[l][6] = s[l][7] = 0.0f;
+        }
+
+        const int blocked = numSamples - numSamples % length;
+
+        for (int start = 0; start < blocked; start += length)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                // Read before any band of this block is written (outputs may alias inputs)
+                float x[length];
+                for (int i = 0; i < length; ++i)
+                    x[i] = inputs[ch][start + i];
+
+                for (int b = firstBand; b < bands; ++b)
+                {
+                    const auto& form = state.blockForms[b];
+                    float* const lane = s[ch * bands + b];
+
+                    float y[length];
+                    if (single && state.slopeLane[b] != 0.0f)
+                        stepBlock<true>(form, x, lane, y);
+                    else
+                        stepBlock<false>(form, x, lane, y);
+
+                    float* const EQ4_RESTRICT out = bandOutputs[b][ch] + start;
+                    for (int i = 0; i < length; ++i)
+                        out[i] = y[i];
+                }
+            }
+        }
+
+        for (int l = 0; l < lanes; ++l)
+        {
+            state.z1[0][l] = s[l][0];
+            state.z2[0][l] = s[l][1];
+            state.z1[1][l] = s[l][2];
+            state.z2[1][l] = s[l][3];
+            state.dcPrevX[l] = s[l][4];
+            state.dcPrevY[l] = s[l][5];
+        }
+
+        if (blocked < numSamples)
+        {
+            const float* tailInputs[SplitState::maxChannels];
+            float* tailBands[bands][SplitState::maxChannels];
+            float* const* tailOutputs[bands];
+            for (int b = 0; b < bands; ++b)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    tailBands[b][ch] = bandOutputs[b][ch] + blocked;
+                tailOutputs[b] = tailBands[b];
+            }
+            for (int ch = 0; ch < numChannels; ++ch)
+                tailInputs[ch] = inputs[ch] + blocked;
+
+            splitLanes<lanes>(state, tailInputs, numChannels, tailOutputs, numSamples - blocked, nullptr, slopeBlendConstant);
+        }
+    }
+
+    //==============================================================================
+    void splitBands(SplitState& state, const float* const* inputs, int numChannels,
+                    float* const* const* bandOutputs, int numSamples,
+                    const float* slopeBlend, float slopeBlendConstant)
+    {
+        if (numSamples <= 0 || state.scratch == nullptr || state.scratchFrames <= 0)
+            return;
+
+        // With 8- and 16-wide vectors the block form is about twice as fast for mono and
+        // stereo; on the 4-wide baseline it loses to the lanes. A per-sample blend (slope
+        // crossfade in progress) always runs on the lanes.
+        constexpr bool useBlocks = EQ4_KERNEL_LEVEL != Level::baseline;
+        numChannels = numChannels >= 2 ? SplitState::maxChannels : 1;
+        if (useBlocks && slopeBlend == nullptr)
+        {
+            splitBlocks(state, inputs, numChannels, bandOutputs, numSamples, slopeBlendConstant);
+            return;
+        }
+
+        // Mono only touches the first four lanes, half the work where four lanes are a whole
+        // vector; wider levels keep the stereo shape, which costs the same. Either way each
+        // lane runs the same expressions, so a channel's bits don't depend on its partner.
+        constexpr bool monoLanes = EQ4_KERNEL_LEVEL == Level::baseline;
+        if (numChannels >= 2 || ! monoLanes)
+            splitLanes<SplitState::maxLanes>(state, inputs, numChannels, bandOutputs, numSamples, slopeBlend, slopeBlendConstant);
+        else
+            splitLanes<SplitState::bandsPerChannel>(state, inputs, 1, bandOutputs, numSamples, slopeBlend, slopeBlendConstant);
+    }
+
+    void mixBands(float* output, const float* const* bands, const float* const* gains,
+                  const float* const* bypasses, int numSamples)
+    {
+        float* const EQ4_RESTRICT out = output;
+        const float* const EQ4_RESTRICT b0 = bands[0];
+        const float* const EQ4_RESTRICT b1 = bands[1];
+        const float* const EQ4_RESTRICT b2 = bands[2];
+        const float* const EQ4_RESTRICT b3 = bands[3];
+        const float* const EQ4_RESTRICT g0 = gains[0];
+        const float* const EQ4_RESTRICT g1 = gains[1];
+        const float* const EQ4_RESTRICT g2 = gains[2];
+        const float* const EQ4_RESTRICT g3 = gains[3];
+        const float* const EQ4_RESTRICT p0 = bypasses[0];
+        const float* const EQ4_RESTRICT p1 = bypasses[1];
+        const float* const EQ4_RESTRICT p2 = bypasses[2];
+        const float* const EQ4_RESTRICT p3 = bypasses[3];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            out[i] = (b0[i] * g0[i] * p0[i]) +
+                     (b1[i] * g1[i] * p1[i]) +
+                     (b2[i] * g2[i] * p2[i]) +
+                     (b3[i] * g3[i] * p3[i]);
+        }
+    }
+
+    void mixBandsMidSide(float* left, float* right,
+                         const float* const* midBands, const float* const* midGains, const float* const* midBypasses,
+                         const float* const* sideBands, const float* const* sideGains, const float* const* sideBypasses,
+                         int numSamples)
+    {
+        float* const EQ4_RESTRICT l = left;
+        float* const EQ4_RESTRICT r = right;
+        const float* const EQ4_RESTRICT m0 = midBands[0];
+        const float* const EQ4_RESTRICT m1 = midBands[1];
+        const float* const EQ4_RESTRICT m2 = midBands[2];
+        const float* const EQ4_RESTRICT m3 = midBands[3];
+        const float* const EQ4_RESTRICT s0 = sideBands[0];
+        const float* const EQ4_RESTRICT s1 = sideBands[1];
+        const float* const EQ4_RESTRICT s2 = sideBands[2];
+        const float* const EQ4_RESTRICT s3 = sideBands[3];
+        const float* const EQ4_RESTRICT mg0 = midGains[0];
+        const float* const EQ4_RESTRICT mg1 = midGains[1];
+        const float* const EQ4_RESTRICT mg2 = midGains[2];
+        const float* const EQ4_RESTRICT mg3 = midGains[3];
+        const float* const EQ4_RESTRICT mp0 = midBypasses[0];
+        const float* const EQ4_RESTRICT mp1 = midBypasses[1];
+        const float* const EQ4_RESTRICT mp2 = midBypasses[2];
+        const float* const EQ4_RESTRICT mp3 = midBypasses[3];
+        const float* const EQ4_RESTRICT sg0 = sideGains[0];
+        const float* const EQ4_RESTRICT sg1 = sideGains[1];
+        const float* const EQ4_RESTRICT sg2 = sideGains[2];
+        const float* const EQ4_RESTRICT sg3 = sideGains[3];
+        const float* const EQ4_RESTRICT sp0 = sideBypasses[0];
+        const float* const EQ4_RESTRICT sp1 = sideBypasses[1];
+        const float* const EQ4_RESTRICT sp2 = sideBypasses[2];
+        const float* const EQ4_RESTRICT sp3 = sideBypasses[3];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float mid = (m0[i] * mg0[i] * mp0[i]) +
+                              (m1[i] * mg1[i] * mp1[i]) +
+                              (m2[i] * mg2[i] * mp2[i]) +
+                              (m3[i] * mg3[i] * mp3[i]);
+            const float side = (s0[i] * sg0[i] * sp0[i]) +
+                               (s1[i] * sg1[i] * sp1[i]) +
+                               (s2[i] * sg2[i] * sp2[i]) +
+                               (s3[i] * sg3[i] * sp3[i]);
+            l[i] = mid + side;
+            r[i] = mid - side;
+        }
+    }
+
+    void applyGain(float* data, const float* gain, const float* bypass, int numSamples)
+    {
+        float* const EQ4_RESTRICT d = data;
+        const float* const EQ4_RESTRICT g = gain;
+        const float* const EQ4_RESTRICT p = bypass;
+
+        for (int i = 0; i < numSamples; ++i)
+            d[i] *= g[i] * p[i];
+    }
+
+    void absMax(float* peak, const float* input, int numSamples, bool accumulate)
+    {
+        float* const EQ4_RESTRICT out = peak;
+        const float* const EQ4_RESTRICT in = input;
+
+        if (accumulate)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = maximum(out[i], absolute(in[i]));
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = absolute(in[i]);
+        }
+    }
+
+    // prefixMask[m][k] = 1 where step m counts towards the running sum at k (m <= k)
+    alignas(64) constexpr double prefixMask[8][8] {
+        { 1, 1, 1, 1, 1, 1, 1, 1 }, { 0, 1, 1, 1, 1, 1, 1, 1 }, { 0, 0, 1, 1, 1, 1, 1, 1 }, { 0, 0, 0, 1, 1, 1, 1, 1 },
+        { 0, 0, 0, 0, 1, 1, 1, 1 }, { 0, 0, 0, 0, 0, 1, 1, 1 }, { 0, 0, 0, 0, 0, 0, 1, 1 }, { 0, 0, 0, 0, 0, 0, 0, 1 }
+    };
+
+    void boxFilter(float* data, const float* leaving, int numSamples, double* sum, double scale)
+    {
+        constexpr int length = 8;
+        float* const EQ4_RESTRICT g = data;
+        const float* const EQ4_RESTRICT old = leaving;
+        double total = *sum;
+
+        // Two doubles per vector on the baseline: there the triangle costs more than the serial adds
+        constexpr bool useBlocks = EQ4_KERNEL_LEVEL != Level::baseline;
+        const int blocked = useBlocks ? numSamples - numSamples % length : 0;
+
+        for (int start = 0; start < blocked; start += length)
+        {
+            double step[length];
+            for (int k = 0; k < length; ++k)
+                step[k] = (double) g[start + k] - (double) old[start + k];
+
+            // Prefix within the block as a triangular sum, vectorised over k like the split's
+            // block form, so only the running total carries from block to block
+            double prefix[length];
+            for (int k = 0; k < length; ++k)
+                prefix[k] = step[0] * prefixMask[0][k] + step[1] * prefixMask[1][k]
+                          + step[2] * prefixMask[2][k] + step[3] * prefixMask[3][k]
+                          + step[4] * prefixMask[4][k] + step[5] * prefixMask[5][k]
+                          + step[6] * prefixMask[6][k] + step[7] * prefixMask[7][k];
+
+            for (int k = 0; k < length; ++k)
+                g[start + k] = (float) ((total + prefix[k]) * scale);
+            total += prefix[length - 1];
+        }
+
+        for (int i = blocked; i < numSamples; ++i)
+        {
+            total += (double) g[i] - (double) old[i];
+            g[i] = (float) (total * scale);
+        }
+
+        *sum = total;
+    }
+
+    void bandDynamics(DynamicsState& state, float* const* detectors, float* const* gains,
+                      float* const* sideGains, int numSamples)
+    {
+        constexpr int lanes = DynamicsState::lanes;
+
+        // Static curve per band in log2 units, vectorised over time in fixed-width
+        // chunks; the detector buffers are reused for the target gain change
+        constexpr int chunk = 16;
+        const int chunked = numSamples - numSamples % chunk;
+
+        for (int l = 0; l < lanes; ++l)
+        {
+            float* const EQ4_RESTRICT d = detectors[l];
+            const float threshold = state.threshold[l];
+            const float above = state.slopeAbove[l];
+            const float below = state.slopeBelow[l];
+            const float floor = state.floor[l];
+
+            auto curve = [=](float peak) noexcept
+            {
+                const float distance = fastLog2(peak + 1.0e-9f) - threshold;
+                const float over = 0.5f * (magnitude(distance) + distance);
+                const float under = over - distance;
+                return larger(floor, above * over - below * under);
+            };
+
+            for (int start = 0; start < chunked; start += chunk)
+                for (int k = 0; k < chunk; ++k)
+                    d[start + k] = curve(d[start + k]);
+            for (int i = chunked; i < numSamples; ++i)
+                d[i] = curve(d[i]);
+        }
+
+        // Ballistics: the only recursive part, the four bands side by side.
+        // fall * max(distance, 0) + rise * min(distance, 0) without a branch,
+        // as mean * distance + spread * |distance| (short dependency chain).
+        float mean[lanes], spread[lanes], change[lanes];
+        for (int l = 0; l < lanes; ++l)
+        {
+            mean[l] = 0.5f * (state.fallCoefficient[l] + state.riseCoefficient[l]);
+            spread[l] = 0.5f * (state.fallCoefficient[l] - state.riseCoefficient[l]);
+            change[l] = state.gainChange[l];
+        }
+
+        // Interleaved in chunks so each step loads and stores one whole frame
+        for (int start = 0; start < numSamples; start += chunk)
+        {
+            const int count = minimum(chunk, numSamples - start);
+            float frames[chunk][lanes];
+
+            for (int l = 0; l < lanes; ++l)
+                for (int k = 0; k < count; ++k)
+                    frames[k][l] = detectors[l][start + k];
+
+            for (int k = 0; k < count; ++k)
+            {
+                for (int l = 0; l < lanes; ++l)
+                {
+                    const float distance = change[l] - frames[k][l]; // > 0 while the gain falls
+                    change[l] = (frames[k][l] + mean[l] * distance) + spread[l] * magnitude(distance);
+                    frames[k][l] = change[l];
+                }
+            }
+
+            for (int l = 0; l < lanes; ++l)
+                for (int k = 0; k < count; ++k)
+                    detectors[l][start + k] = frames[k][l];
+        }
+
+        for (int l = 0; l < lanes; ++l)
+            state.gainChange[l] = change[l];
+
+        // Back to linear and into the gain curves, vectorised over time
+        for (int l = 0; l < lanes; ++l)
+        {
+            const float* const EQ4_RESTRICT d = detectors[l];
+            float* const EQ4_RESTRICT g = gains[l];
+            float* const EQ4_RESTRICT sg = sideGains != nullptr ? sideGains[l] : nullptr;
+
+            for (int start = 0; start < chunked; start += chunk)
+            {
+                float linear[chunk];
+                for (int k = 0; k < chunk; ++k)
+                    linear[k] = fastExp2(d[start + k]);
+                for (int k = 0; k < chunk; ++k)
+                    g[start + k] *= linear[k];
+                if (sg != nullptr)
+                    for (int k = 0; k < chunk; ++k)
+                        sg[start + k] *= linear[k];
+            }
+            for (int i = chunked; i < numSamples; ++i)
+            {
+                const float linear = fastExp2(d[i]);
+                g[i] *= linear;
+                if (sg != nullptr)
+                    sg[i] *= linear;
+            }
+        }
+    }
+}
+
+    extern const Table table;
+    const Table table { EQ4_KERNEL_NAME, EQ4_KERNEL_LEVEL, splitBands, mixBands, mixBandsMidSide, applyGain, absMax, boxFilter, bandDynamics };
+}
+}
+
+#undef EQ4_RESTRICT
+#undef EQ4_BIT_COPY
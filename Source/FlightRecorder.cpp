@@ -0,0 +1,431 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "FlightRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+namespace
+{
+    constexpr char fileMagic[8] = { 'E', 'Q', '4', 'F', 'L', 'T', '1', '\0' };
+
+    // Every block is at least this long on average, or the oldest records run out before the audio
+    constexpr int averageBlockSize = 32;
+
+    // Audio per channel copied out of the rings at a time by the writer (whole blocks, at least one)
+    constexpr std::uint64_t chunkSamples = 1 << 16;
+
+    double numberFromEnvironment(const char* name, double fallback)
+    {
+        const char* value = std::getenv(name);
+        return (value != nullptr && *value != 0) ? std::atof(value) : fallback;
+    }
+
+    template <typename Value>
+    bool writeValue(std::FILE* file, Value value)
+    {
+        return std::fwrite(&value, sizeof(value), 1, file) == 1;
+    }
+
+    template <typename Value>
+    bool readValue(std::FILE* file, Value& value)
+    {
+        return std::fread(&value, sizeof(value), 1, file) == 1;
+    }
+
+    struct FileCloser
+    {
+        void operator()(std::FILE* file) const { std::fclose(file); }
+    };
+}
+
+//==============================================================================
+FlightRecorder::FlightRecorder()
+{
+    recordSeconds = std::min(600.0, numberFromEnvironment("EQISOLATOR4_FLIGHT_RECORDER", 0.0));
+    enabled = recordSeconds > 0.0;
+    overrunFraction = (float) std::max(1.0, numberFromEnvironment("EQISOLATOR4_FLIGHT_RECORDER_OVERRUN", 50.0)) * 0.01f;
+
+    if (const char* configured = std::getenv("EQISOLATOR4_FLIGHT_RECORDER_DIR"))
+        folder = configured;
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    if (! writer.joinable())
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock(writerLock);
+        stopRequested = true;
+    }
+    wakeUp.notify_one();
+    writer.join();
+}
+
+void FlightRecorder::prepare(double newSampleRate, int newMaximumBlockSize, int newNumChannels,
+                             const std::vector<std::string>& newParameterIds)
+{
+    if (! enabled)
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock(ringLock);
+
+        sampleRate = newSampleRate;
+        maximumBlockSize = std::max(1, newMaximumBlockSize);
+        numChannels = std::max(1, std::min(newNumChannels, maxChannels));
+        numParameters = std::min((int) newParameterIds.size(), maxParameters);
+        parameterIds.assign(newParameterIds.begin(), newParameterIds.begin() + numParameters);
+
+        // Room for the requested length plus the block being written
+        audioCapacity = (std::uint64_t) std::ceil(recordSeconds * sampleRate) + (std::uint64_t) maximumBlockSize;
+        audioRing.assign((size_t) numChannels, std::vector<float>((size_t) audioCapacity, 0.0f));
+        blockRing.assign((size_t) (audioCapacity / averageBlockSize + 1), BlockRecord {});
+
+        // A new layout starts a new recording; a capture being written is abandoned
+        samplesWritten.store(0, std::memory_order_relaxed);
+        blocksWritten.store(0, std::memory_order_relaxed);
+        samplesReserved.store(0, std::memory_order_relaxed);
+        blocksReserved.store(0, std::memory_order_relaxed);
+        ++ringGeneration;
+        pendingSample = 0;
+        blockPending = false;
+        nextAutomaticDumpSample = 0;
+    }
+
+    if (! writer.joinable())
+        writer = std::thread([this] { runWriter(); });
+}
+
+//==============================================================================
+void FlightRecorder::recordInput(const float* const* channels, int numInputChannels, int numSamples,
+                                 const float* parameterValues, int numValues, bool nonRealtime) noexcept
+{
+    blockPending = false;
+    if (audioCapacity == 0 || numSamples <= 0 || numSamples > maximumBlockSize)
+        return;
+
+    const std::uint64_t first = samplesWritten.load(std::memory_order_relaxed);
+    const std::uint64_t index = blocksWritten.load(std::memory_order_relaxed);
+
+    // Seqlock: announce the audio and record slot about to be overwritten before touching them
+    samplesReserved.store(first + (std::uint64_t) numSamples, std::memory_order_relaxed);
+    blocksReserved.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t position = (size_t) (first % audioCapacity);
+    const size_t head = std::min((size_t) numSamples, (size_t) audioCapacity - position);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* const ring = audioRing[(size_t) channel].data();
+        if (channel < numInputChannels)
+        {
+            std::memcpy(ring + position, channels[channel], head * sizeof(float));
+            std::memcpy(ring, channels[channel] + head, ((size_t) numSamples - head) * sizeof(float));
+        }
+        else
+        {
+            std::memset(ring + position, 0, head * sizeof(float));
+            std::memset(ring, 0, ((size_t) numSamples - head) * sizeof(float));
+        }
+    }
+
+    auto& record = blockRing[(size_t) (index % blockRing.size())];
+    record.firstSample = first;
+    record.numSamples = (std::uint32_t) numSamples;
+    record.flags = nonRealtime ? flagNonRealtime : 0u;
+    record.elapsedMs = 0.0f;
+    record.governorTier = 0;
+
+    const int numCopied = std::min(numValues, numParameters);
+    std::memcpy(record.parameters, parameterValues, (size_t) numCopied * sizeof(float));
+    std::fill(record.parameters + numCopied, record.parameters + maxParameters, 0.0f);
+
+    pendingSample = first + (std::uint64_t) numSamples;
+    blockPending = true;
+}
+
+void FlightRecorder::recordTiming(double elapsedSeconds, int governorTier) noexcept
+{
+    if (! blockPending)
+        return;
+    blockPending = false;
+
+    const std::uint64_t index = blocksWritten.load(std::memory_order_relaxed);
+    auto& record = blockRing[(size_t) (index % blockRing.size())];
+    record.elapsedMs = (float) (elapsedSeconds * 1000.0);
+    record.governorTier = governorTier;
+
+    samplesWritten.store(pendingSample, std::memory_order_release);
+    blocksWritten.store(index + 1, std::memory_order_release);
+
+    // Offline renders have no deadline; after a dump, wait until the ring has been refilled
+    const double deadline = (double) record.numSamples / sampleRate;
+    if ((record.flags & flagNonRealtime) == 0 && elapsedSeconds > deadline * overrunFraction
+        && pendingSample >= nextAutomaticDumpSample)
+    {
+        nextAutomaticDumpSample = pendingSample + audioCapacity;
+        int none = -1;
+        dumpRequest.compare_exchange_strong(none, reasonOverrun, std::memory_order_relaxed);
+    }
+}
+
+void FlightRecorder::requestDump() noexcept
+{
+    dumpRequest.store(reasonRequested, std::memory_order_relaxed);
+}
+
+std::string FlightRecorder::getLastCapturePath() const
+{
+    const std::lock_guard<std::mutex> lock(pathLock);
+    return lastCapturePath;
+}
+
+//==============================================================================
+void FlightRecorder::runWriter()
+{
+    std::unique_lock<std::mutex> lock(writerLock);
+    while (! stopRequested)
+    {
+        wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+
+        const int reason = dumpRequest.exchange(-1, std::memory_order_relaxed);
+        if (reason >= 0)
+        {
+            lock.unlock();
+            writeCapture(reason);
+            lock.lock();
+        }
+    }
+}
+
+void FlightRecorder::writeCapture(int reason)
+{
+    // Streamed to the file a chunk at a time, oldest block first. ringLock is held only while
+    // a chunk is copied, so prepare() never waits on the disk (and abandons the capture).
+    // Each copied chunk is checked against the reserved counters, as a seqlock: blocks the
+    // audio thread overwrote meanwhile are dropped, and since a capture must be contiguous,
+    // so is everything written before them.
+    std::uint64_t generation = 0, firstBlock = 0, endBlock = 0, slots = 0, capacity = 0;
+    double rate = 0.0;
+    int blockSize = 0, channelCount = 0, parameterCount = 0;
+    std::vector<std::string> ids;
+
+    {
+        const std::lock_guard<std::mutex> lock(ringLock);
+        if (audioCapacity == 0)
+            return;
+
+        generation = ringGeneration;
+        endBlock = blocksWritten.load(std::memory_order_acquire);
+        slots = blockRing.size();
+        firstBlock = endBlock > slots ? endBlock - slots : 0;
+        capacity = audioCapacity;
+        rate = sampleRate;
+        blockSize = maximumBlockSize;
+        channelCount = numChannels;
+        parameterCount = numParameters;
+        ids = parameterIds;
+    }
+
+    if (firstBlock == endBlock)
+        return;
+
+    std::string path;
+    {
+        std::error_code error;
+        const auto directory = folder.empty() ? std::filesystem::temp_directory_path(error) : std::filesystem::path(folder);
+        const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        path = (directory / ("EQIsolator4-flight-" + std::to_string(stamp) + ".eq4f")).string();
+    }
+
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.c_str(), "wb"));
+    if (file == nullptr)
+        return;
+
+    // The block count is only known at the end; written as 0 here and patched
+    bool written = std::fwrite(fileMagic, sizeof(fileMagic), 1, file.get()) == 1
+                && writeValue(file.get(), (std::uint32_t) reason)
+                && writeValue(file.get(), rate)
+                && writeValue(file.get(), (std::uint32_t) blockSize)
+                && writeValue(file.get(), (std::uint32_t) channelCount)
+                && writeValue(file.get(), (std::uint32_t) parameterCount);
+
+    const long countPosition = std::ftell(file.get());
+    written = written && writeValue(file.get(), (std::uint32_t) 0);
+
+    for (const auto& id : ids)
+        written = written && writeValue(file.get(), (std::uint16_t) id.size())
+                          && std::fwrite(id.data(), 1, id.size(), file.get()) == id.size();
+
+    const long dataPosition = std::ftell(file.get());
+    std::uint32_t numBlocksWritten = 0;
+    bool rewound = false;
+
+    std::vector<BlockRecord> records;
+    std::vector<float> audio; // per block: planar channels, as in the file
+
+    for (std::uint64_t next = firstBlock; written && next < endBlock;)
+    {
+        const std::uint64_t chunkFirst = next;
+        records.clear();
+        audio.clear();
+
+        {
+            const std::lock_guard<std::mutex> lock(ringLock);
+            if (ringGeneration != generation)
+            {
+                written = false;
+                break;
+            }
+
+            // Sizes and positions are bounded even in a slot being overwritten, so the copy
+            // stays inside the rings; the check below decides whether it is kept
+            std::uint64_t chunkLength = 0;
+            for (; next < endBlock && (records.empty() || chunkLength < chunkSamples); ++next)
+            {
+                records.push_back(blockRing[(size_t) (next % slots)]);
+                const auto& record = records.back();
+                chunkLength += record.numSamples;
+
+                const size_t position = (size_t) (record.firstSample % capacity);
+                const size_t head = std::min((size_t) record.numSamples, (size_t) capacity - position);
+                for (const auto& channel : audioRing)
+                {
+                    audio.insert(audio.end(), channel.data() + position, channel.data() + position + head);
+                    audio.insert(audio.end(), channel.data(), channel.data() + (record.numSamples - head));
+                }
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t reservedBlocks = blocksReserved.load(std::memory_order_relaxed);
+        const std::uint64_t reservedSamples = samplesReserved.load(std::memory_order_relaxed);
+
+        // Overwriting runs oldest first, so only a prefix of the chunk can be lost
+        size_t dropped = 0;
+        size_t droppedAudio = 0;
+        while (dropped < records.size()
+               && (chunkFirst + dropped + slots < reservedBlocks || records[dropped].firstSample + capacity < reservedSamples))
+        {
+            droppedAudio += (size_t) records[dropped].numSamples * (size_t) channelCount;
+            ++dropped;
+        }
+
+        if (dropped > 0 && numBlocksWritten > 0)
+        {
+            written = std::fseek(file.get(), dataPosition, SEEK_SET) == 0;
+            numBlocksWritten = 0;
+            rewound = true;
+        }
+
+        const float* input = audio.data() + droppedAudio;
+        for (size_t i = dropped; written && i < records.size(); ++i)
+        {
+            const auto& record = records[i];
+            const size_t inputLength = (size_t) record.numSamples * (size_t) channelCount;
+            written = writeValue(file.get(), record.numSamples)
+                   && writeValue(file.get(), record.flags)
+                   && writeValue(file.get(), record.elapsedMs)
+                   && writeValue(file.get(), record.governorTier)
+                   && std::fwrite(record.parameters, sizeof(float), (size_t) parameterCount, file.get()) == (size_t) parameterCount
+                   && std::fwrite(input, sizeof(float), inputLength, file.get()) == inputLength;
+            input += inputLength;
+            ++numBlocksWritten;
+        }
+    }
+
+    const long endPosition = std::ftell(file.get());
+    written = written && numBlocksWritten > 0
+           && std::fseek(file.get(), countPosition, SEEK_SET) == 0
+           && writeValue(file.get(), numBlocksWritten);
+    file.reset();
+
+    // A rewind can leave the end of a longer first attempt behind the last block
+    if (written && rewound)
+    {
+        std::error_code error;
+        std::filesystem::resize_file(path, (std::uintmax_t) endPosition, error);
+        written = ! error;
+    }
+
+    if (written)
+    {
+        const std::lock_guard<std::mutex> pathGuard(pathLock);
+        lastCapturePath = path;
+    }
+    else
+    {
+        std::remove(path.c_str());
+    }
+}
+
+//==============================================================================
+bool FlightRecorder::Capture::load(const std::string& path)
+{
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.c_str(), "rb"));
+    if (file == nullptr)
+        return false;
+
+    char magic[sizeof(fileMagic)] = {};
+    std::uint32_t blockSize = 0, channels = 0, parameters = 0, numBlocks = 0;
+
+    if (std::fread(magic, sizeof(magic), 1, file.get()) != 1 || std::memcmp(magic, fileMagic, sizeof(magic)) != 0
+        || ! readValue(file.get(), reason) || ! readValue(file.get(), sampleRate) || ! readValue(file.get(), blockSize)
+        || ! readValue(file.get(), channels) || ! readValue(file.get(), parameters) || ! readValue(file.get(), numBlocks))
+        return false;
+
+    if (! (sampleRate > 0.0) || blockSize == 0 || channels == 0 || channels > (std::uint32_t) maxChannels
+        || parameters > (std::uint32_t) maxParameters)
+        return false;
+
+    maximumBlockSize = (int) blockSize;
+    numChannels = (int) channels;
+
+    parameterIds.clear();
+    for (std::uint32_t i = 0; i < parameters; ++i)
+    {
+        std::uint16_t length = 0;
+        if (! readValue(file.get(), length))
+            return false;
+
+        std::string id(length, '\0');
+        if (std::fread(&id[0], 1, length, file.get()) != length)
+            return false;
+        parameterIds.push_back(std::move(id));
+    }
+
+    blocks.clear();
+    blocks.reserve(numBlocks);
+    for (std::uint32_t b = 0; b < numBlocks; ++b)
+    {
+        Block block;
+        if (! readValue(file.get(), block.numSamples) || ! readValue(file.get(), block.flags)
+            || ! readValue(file.get(), block.elapsedMs) || ! readValue(file.get(), block.governorTier)
+            || block.numSamples == 0 || block.numSamples > blockSize)
+            return false;
+
+        block.parameters.resize(parameters);
+        block.input.resize((size_t) channels * block.numSamples);
+        if (std::fread(block.parameters.data(), sizeof(float), parameters, file.get()) != parameters
+            || std::fread(block.input.data(), sizeof(float), block.input.size(), file.get()) != block.input.size())
+            return false;
+
+        blocks.push_back(std::move(block));
+    }
+
+    return ! blocks.empty();
+}
@@ -0,0 +1,166 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+/**
+ * Audio-thread flight recorder, opt-in with EQISOLATOR4_FLIGHT_RECORDER=<seconds>.
+ *
+ * Keeps the last few seconds of input audio and, for every block, its size,
+ * all parameter values (normalised), the processing time and the governor
+ * tier, in rings allocated by prepare(). Recording a block is a copy of its
+ * input plus one fixed-size record: no locks, no allocation.
+ *
+ * A writer thread saves the rings to a capture file when requestDump() is
+ * called, or by itself when a block takes longer than the overrun threshold
+ * (EQISOLATOR4_FLIGHT_RECORDER_OVERRUN, percent of the block's duration,
+ * default 50; at most once per ring length). Files are named
+ * EQIsolator4-flight-<time>.eq4f, in EQISOLATOR4_FLIGHT_RECORDER_DIR or the
+ * temp directory. Tools/FlightReplay plays a capture back through the
+ * processor.
+ *
+ * The writer streams the recorded range to the file in chunks while recording
+ * goes on: the audio thread announces what it is about to overwrite (a
+ * seqlock), and blocks overwritten before their chunk was copied are dropped
+ * from the start of the capture.
+ */
+class FlightRecorder
+{
+public:
+    static constexpr int maxParameters = 64;
+    static constexpr int maxChannels = 2;
+
+    // Block flags
+    static constexpr std::uint32_t flagNonRealtime = 1u << 0;
+
+    // Why a capture was written
+    enum Reason { reasonRequested = 0, reasonOverrun };
+
+    /** Reads the environment; stays disabled (and allocates nothing) unless asked for. */
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    bool isEnabled() const noexcept { return enabled; }
+
+    /** Allocates the rings and starts the writer; not concurrent with the audio thread. */
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, const std::vector<std::string>& parameterIds);
+
+    //==============================================================================
+    // Audio thread, in this order once per block
+
+    /** Copies the block's input (before processing) and the parameter values. */
+    void recordInput(const float* const* channels, int numChannels, int numSamples,
+                     const float* parameterValues, int numParameters, bool nonRealtime) noexcept;
+
+    /** Completes the block started by recordInput(); checks it against the deadline. */
+    void recordTiming(double elapsedSeconds, int governorTier) noexcept;
+
+    //==============================================================================
+    /** Any thread: the writer saves the rings on its next wake-up (within 100 ms). */
+    void requestDump() noexcept;
+
+    /** Path of the last capture written, empty if none yet. */
+    std::string getLastCapturePath() const;
+
+    //==============================================================================
+    // Capture file: little-endian, all integers fixed width.
+    //   header:  "EQ4FLT1\0", u32 reason, f64 sample rate, u32 max block size,
+    //            u32 channels, u32 parameters, u32 blocks,
+    //            then per parameter: u16 length + id bytes
+    //   block:   u32 samples, u32 flags, f32 elapsed ms, i32 governor tier,
+    //            f32 parameter values, then the input, planar (f32 per sample)
+    struct Block
+    {
+        std::uint32_t numSamples = 0;
+        std::uint32_t flags = 0;
+        float elapsedMs = 0.0f;
+        std::int32_t governorTier = 0;
+        std::vector<float> parameters;
+        std::vector<float> input; // numChannels * numSamples, planar
+    };
+
+    struct Capture
+    {
+        std::uint32_t reason = reasonRequested;
+        double sampleRate = 0.0;
+        int maximumBlockSize = 0;
+        int numChannels = 0;
+        std::vector<std::string> parameterIds;
+        std::vector<Block> blocks;
+
+        /** Reads a capture file; false if it can't be opened, is malformed or holds no blocks. */
+        bool load(const std::string& path);
+    };
+
+private:
+    struct BlockRecord
+    {
+        std::uint64_t firstSample;    // position of the input in the audio ring's running count
+        std::uint32_t numSamples;
+        std::uint32_t flags;
+        float elapsedMs;
+        std::int32_t governorTier;
+        float parameters[maxParameters];
+    };
+
+    void runWriter();
+    void writeCapture(int reason);
+
+    bool enabled = false;
+    double recordSeconds = 0.0;
+    float overrunFraction = 0.5f;
+    std::string folder;
+
+    // Set up by prepare() under ringLock, which the writer holds while it copies a chunk;
+    // the generation tells it the rings were replaced in between
+    std::mutex ringLock;
+    std::uint64_t ringGeneration = 0;
+    double sampleRate = 0.0;
+    int maximumBlockSize = 0;
+    int numChannels = 0;
+    int numParameters = 0;
+    std::vector<std::string> parameterIds;
+
+    std::vector<std::vector<float>> audioRing; // [channel][audioCapacity]
+    std::uint64_t audioCapacity = 0;
+    std::vector<BlockRecord> blockRing;
+
+    // Published by recordTiming() (release), read by the writer (acquire)
+    std::atomic<std::uint64_t> samplesWritten { 0 };
+    std::atomic<std::uint64_t> blocksWritten { 0 };
+
+    // Seqlock side: ends of the audio and records recordInput() is writing, stored (then a
+    // release fence) before it writes; the writer reads them after copying a chunk
+    std::atomic<std::uint64_t> samplesReserved { 0 };
+    std::atomic<std::uint64_t> blocksReserved { 0 };
+
+    // Audio thread only: the block in progress and the automatic dump hold-off
+    std::uint64_t pendingSample = 0;
+    bool blockPending = false;
+    std::uint64_t nextAutomaticDumpSample = 0;
+
+    std::atomic<int> dumpRequest { -1 }; // Reason, -1 = none
+
+    std::thread writer;
+    std::mutex writerLock;
+    std::condition_variable wakeUp;
+    bool stopRequested = false;
+
+    mutable std::mutex pathLock;
+    std::string lastCapturePath;
+};
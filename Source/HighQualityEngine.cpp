@@ -0,0 +1,372 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "HighQualityEngine.h"
+#include "PluginProcessor.h"
+#include "StageProfiler.h"
+
+#include <cstring>
+
+//==============================================================================
+namespace
+{
+    // Linear-phase half-band lowpass at the oversampled rate, in the form MultirateLowBranch
+    // uses: the centre tap (0.5) and symmetric pairs at odd offsets, every other tap zero.
+    // The same filter interpolates and decimates, so a round trip is 2 * centre samples at
+    // the oversampled rate, i.e. 'centre' samples at the host rate.
+    struct HalfBand
+    {
+        int centre = 0;
+        std::vector<double> pairs; // h[centre +- (2k + 1)]
+    };
+
+    // JUCE's equiripple half-band with the first stage settings of its max-quality 2x Oversampling
+    // (0.05 transition width, -90 dB), reduced to the centre and pairs and renormalised for unity gain at DC
+    const HalfBand& getHalfBand()
+    {
+        static const HalfBand halfBand = []
+        {
+            const auto fir = juce::dsp::FilterDesign<double>::designFIRLowpassHalfBandEquirippleMethod(0.05, -90.0);
+            const double* taps = fir->getRawCoefficients();
+            jassert(fir->getFilterOrder() % 2 == 0);
+
+            HalfBand result;
+            result.centre = (int) fir->getFilterOrder() / 2;
+
+            double sum = 0.0;
+            for (int offset = 1; offset <= result.centre; offset += 2)
+            {
+                result.pairs.push_back(taps[result.centre + offset]);
+                sum += taps[result.centre + offset];
+            }
+
+            // 0.5 + 2 * sum(pairs) == 1
+            for (auto& pair : result.pairs)
+                pair *= 0.25 / sum;
+
+            return result;
+        }();
+        return halfBand;
+    }
+
+    // Host rate in, oversampled out: zero-stuffing folded into the two output phases
+    class HalfBandUp
+    {
+    public:
+        void prepare(int maximumBlockSize)
+        {
+            history = getHalfBand().centre;
+            buffer.assign((size_t) (history + maximumBlockSize), 0.0);
+        }
+
+        void reset() noexcept { std::fill(buffer.begin(), buffer.end(), 0.0); }
+
+        /** Writes 2 * numSamples outputs. */
+        void process(const float* input, double* output, int numSamples) noexcept
+        {
+            const auto& halfBand = getHalfBand();
+            double* const x = buffer.data() + history; // x[m - d] valid for d <= centre
+            for (int i = 0; i < numSamples; ++i)
+                x[i] = (double) input[i];
+
+            for (int m = 0; m < numSamples; ++m)
+            {
+                for (int phase = 0; phase < 2; ++phase)
+                {
+                    // Output 2m + phase sits 'lag' samples past the input 2m (at the oversampled rate)
+                    const int lag = halfBand.centre - phase;
+                    double value;
+                    if (lag % 2 == 0)
+                    {
+                        value = x[m - lag / 2]; // 2 * the centre tap
+                    }
+                    else
+                    {
+                        value = 0.0;
+                        for (size_t k = 0; k < halfBand.pairs.size(); ++k)
+                        {
+                            const int offset = 2 * (int) k + 1;
+                            value += halfBand.pairs[k] * (x[m - (lag - offset) / 2] + x[m - (lag + offset) / 2]);
+                        }
+                        value *= 2.0;
+                    }
+                    output[2 * m + phase] = value;
+                }
+            }
+
+            std::memmove(buffer.data(), buffer.data() + numSamples, sizeof(double) * (size_t) history);
+        }
+
+    private:
+        int history = 0;
+        std::vector<double> buffer; // history, then the block
+    };
+
+    // Oversampled in, host rate out: only the kept phase is computed
+    class HalfBandDown
+    {
+    public:
+        void prepare(int maximumBlockSize)
+        {
+            history = 2 * getHalfBand().centre;
+            buffer.assign((size_t) (history + 2 * maximumBlockSize), 0.0);
+        }
+
+        void reset() noexcept { std::fill(buffer.begin(), buffer.end(), 0.0); }
+
+        /** Reads 2 * numSamples inputs. */
+        void process(const double* input, double* output, int numSamples) noexcept
+        {
+            const auto& halfBand = getHalfBand();
+            double* const w = buffer.data() + history;
+            std::copy(input, input + 2 * numSamples, w);
+
+            for (int m = 0; m < numSamples; ++m)
+            {
+                const double* centre = w + 2 * m - halfBand.centre;
+                double value = 0.5 * centre[0];
+                for (size_t k = 0; k < halfBand.pairs.size(); ++k)
+                {
+                    const int offset = 2 * (int) k + 1;
+                    value += halfBand.pairs[k] * (centre[-offset] + centre[offset]);
+                }
+                output[m] = value;
+            }
+
+            std::memmove(buffer.data(), buffer.data() + 2 * numSamples, sizeof(double) * (size_t) history);
+        }
+
+    private:
+        int history = 0;
+        std::vector<double> buffer; // history, then the block
+    };
+}
+
+//==============================================================================
+struct HighQualityEngine::Channel
+{
+    using Filter = juce::dsp::IIR::Filter<double>;
+
+    std::array<std::array<Filter, sectionsPerBand>, numBands> sections;
+
+    // The input is upsampled once and shared by the bands; each band decimates its own output
+    HalfBandUp upsampler;
+    std::array<HalfBandDown, numBands> downsamplers;
+
+    juce::AudioBuffer<double> upsampled, band, output;
+
+    // DC blocker on the Low band, as on the live path
+    double dcR = 0.0, dcPrevX = 0.0, dcPrevY = 0.0;
+};
+
+// One pool for every engine in the process: an instance per plugin would start threads in each
+struct HighQualityEngine::Workers
+{
+    juce::ThreadPool pool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+};
+
+struct HighQualityEngine::ChannelJob : public juce::ThreadPoolJob
+{
+    ChannelJob(HighQualityEngine& owner, int channelIndex)
+        : juce::ThreadPoolJob("HQ channel"), engine(owner), channel(channelIndex) {}
+
+    JobStatus runJob() override
+    {
+        engine.processChannel(channel);
+        return jobHasFinished;
+    }
+
+    HighQualityEngine& engine;
+    const int channel;
+};
+
+namespace
+{
+    using SectionCoefficients = std::array<std::array<juce::dsp::IIR::Coefficients<double>::Ptr, HighQualityEngine::sectionsPerBand>,
+                                           HighQualityEngine::numBands>;
+
+    static_assert(HighQualityEngine::sectionsPerBand == IsolatorCore::steepSectionsPerBand, "one filter per designed section");
+
+    // LR8 sections at the live crossover points, designed in double at the oversampled rate
+    SectionCoefficients makeSections(double sampleRate)
+    {
+        using Processor = EQIsolator4AudioProcessor;
+
+        const auto designed = IsolatorCore::designSteepSections(sampleRate, Processor::LOW_LOWMID_CROSSOVER_FREQ,
+                                                                Processor::LOWMID_MID_CROSSOVER_FREQ, Processor::MID_HIGH_CROSSOVER_FREQ);
+
+        SectionCoefficients sections;
+        for (size_t band = 0; band < (size_t) HighQualityEngine::numBands; ++band)
+        {
+            for (size_t s = 0; s < (size_t) HighQualityEngine::sectionsPerBand; ++s)
+            {
+                const auto& c = designed[band * (size_t) HighQualityEngine::sectionsPerBand + s];
+                sections[band][s] = new juce::dsp::IIR::Coefficients<double>(c[0], c[1], c[2], 1.0, c[3], c[4]);
+            }
+        }
+        return sections;
+    }
+}
+
+//==============================================================================
+HighQualityEngine::HighQualityEngine() = default;
+HighQualityEngine::~HighQualityEngine() = default;
+
+void HighQualityEngine::prepare(double sampleRate, int maximumBlockSize, int numChannels)
+{
+    preparedSampleRate = sampleRate;
+    preparedBlockSize = juce::jmax(1, maximumBlockSize);
+
+    const auto designed = makeSections(sampleRate * 2.0);
+    const juce::dsp::ProcessSpec oversampledSpec { sampleRate * 2.0, (juce::uint32) (preparedBlockSize * 2), 1 };
+
+    channels.clear();
+    for (int c = 0; c < numChannels; ++c)
+    {
+        auto channel = std::make_unique<Channel>();
+
+        channel->upsampler.prepare(preparedBlockSize);
+
+        for (size_t band = 0; band < (size_t) numBands; ++band)
+        {
+            channel->downsamplers[band].prepare(preparedBlockSize);
+
+            for (size_t s = 0; s < (size_t) sectionsPerBand; ++s)
+            {
+                auto& section = channel->sections[band][s];
+                section.coefficients = designed[band][s];
+                section.prepare(oversampledSpec);
+            }
+        }
+
+        channel->upsampled.setSize(1, preparedBlockSize * 2);
+        channel->band.setSize(1, preparedBlockSize * 2);
+        channel->output.setSize(1, preparedBlockSize);
+        channel->dcR = std::exp(-2.0 * juce::MathConstants<double>::pi * 5.0 / sampleRate);
+        channels.push_back(std::move(channel));
+    }
+
+    // Linear-phase half-band both ways: an integer latency that can be reported exactly
+    latencySamples = getHalfBand().centre;
+
+    if (numChannels > 1 && workers == nullptr)
+        workers = std::make_unique<juce::SharedResourcePointer<Workers>>();
+
+    jobs.clear();
+    for (int c = 1; c < numChannels; ++c)
+        jobs.push_back(std::make_unique<ChannelJob>(*this, c));
+
+    reset();
+}
+
+void HighQualityEngine::reset()
+{
+    for (auto& channel : channels)
+    {
+        channel->upsampler.reset();
+        for (size_t band = 0; band < (size_t) numBands; ++band)
+        {
+            channel->downsamplers[band].reset();
+            for (auto& section : channel->sections[band])
+                section.reset();
+        }
+        channel->dcPrevX = channel->dcPrevY = 0.0;
+    }
+}
+
+bool HighQualityEngine::isPreparedFor(double sampleRate, int numChannels) const noexcept
+{
+    return sampleRate == preparedSampleRate
+        && numChannels == (int) channels.size();
+}
+
+//==============================================================================
+void HighQualityEngine::process(const float* const* input, int numChannels, int numSamples,
+                                float* const* const* bandOutputs)
+{
+    numChannels = juce::jmin(numChannels, (int) channels.size());
+    if (numChannels <= 0)
+        return;
+
+    currentInput = input;
+    currentOutputs = bandOutputs;
+    currentNumSamples = numSamples;
+
+    // Channels are independent: all but the first go to the pool, the caller takes channel 0.
+    // A job left the pool once waitForJobToFinish() returns, so it can be queued again next block.
+    if (workers != nullptr)
+    {
+        auto& pool = (*workers)->pool;
+        for (int c = 1; c < numChannels; ++c)
+            pool.addJob(jobs[(size_t) (c - 1)].get(), false);
+
+        processChannel(0);
+
+        for (int c = 1; c < numChannels; ++c)
+            pool.waitForJobToFinish(jobs[(size_t) (c - 1)].get(), -1);
+    }
+    else
+    {
+        for (int c = 0; c < numChannels; ++c)
+            processChannel(c);
+    }
+}
+
+void HighQualityEngine::processChannel(int channelIndex)
+{
+    EQ4_PROFILE_SCOPE("HQ channel");
+    auto& channel = *channels[(size_t) channelIndex];
+    const float* in = currentInput[channelIndex];
+
+    for (int start = 0; start < currentNumSamples; start += preparedBlockSize)
+    {
+        const int n = juce::jmin(preparedBlockSize, currentNumSamples - start);
+
+        double* upsampled = channel.upsampled.getWritePointer(0);
+        {
+            EQ4_PROFILE_SCOPE("HQ upsampler");
+            channel.upsampler.process(in + start, upsampled, n);
+        }
+
+        for (int band = 0; band < numBands; ++band)
+        {
+           #if EQISOLATOR4_PROFILE_STAGES
+            static const char* const chainNames[numBands] = { "HQ low chain", "HQ low-mid chain", "HQ mid chain", "HQ high chain" };
+            StageProfiler::Scope chainScope(chainNames[band]);
+           #endif
+
+            double* work = channel.band.getWritePointer(0);
+            std::copy(upsampled, upsampled + 2 * n, work);
+
+            juce::dsp::AudioBlock<double> block(&work, 1, (size_t) (2 * n));
+            juce::dsp::ProcessContextReplacing<double> context(block);
+            for (auto& section : channel.sections[(size_t) band])
+                section.process(context);
+
+            double* y = channel.output.getWritePointer(0);
+            channel.downsamplers[(size_t) band].process(work, y, n);
+
+            if (band == 0)
+            {
+                EQ4_PROFILE_SCOPE("HQ DC blocker");
+                double prevX = channel.dcPrevX, prevY = channel.dcPrevY;
+                for (int i = 0; i < n; ++i)
+                {
+                    const double sample = y[i];
+                    y[i] = sample - prevX + channel.dcR * prevY;
+                    prevX = sample;
+                    prevY = y[i];
+                }
+                channel.dcPrevX = prevX;
+                channel.dcPrevY = prevY;
+            }
+
+            float* out = currentOutputs[band][channelIndex] + start;
+            for (int i = 0; i < n; ++i)
+                out[i] = (float) y[i];
+        }
+    }
+}
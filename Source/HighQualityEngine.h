@@ -0,0 +1,71 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+//==============================================================================
+/**
+ * Band split used while the host renders offline.
+ *
+ * Same crossover points as the live path, but with eighth-order Linkwitz-Riley
+ * slopes (48 dB/octave, against about 24 live) in a tree with allpass
+ * compensation, so the bands sum flat. Every band runs in double precision at
+ * 2x oversampling (no cramping near Nyquist). Each channel is upsampled once and
+ * the four bands filter that copy, each with its own linear-phase half-band
+ * decimator. Channels are processed in parallel on a small thread pool.
+ * Output is the four ungained bands per channel, so gain, limiting and band
+ * buses downstream are shared with the live path.
+ *
+ * Allocates in prepare() only. The worker pool is shared by every engine in the
+ * process and started by the first prepare() with more than one channel; each
+ * extra channel gets a job in prepare() that is only queued again per block.
+ */
+class HighQualityEngine
+{
+public:
+    static constexpr int numBands = 4;
+    static constexpr int sectionsPerBand = 10;
+
+    HighQualityEngine();
+    ~HighQualityEngine();
+
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels);
+    void reset();
+
+    /** Any block size is split into prepared-size chunks, so only the rate and layout count. */
+    bool isPreparedFor(double sampleRate, int numChannels) const noexcept;
+
+    /** Oversampling round trip, in samples at the host rate. */
+    int getLatencySamples() const noexcept { return latencySamples; }
+
+    /** Splits numChannels of input into bandOutputs[band][channel] (numSamples each). */
+    void process(const float* const* input, int numChannels, int numSamples,
+                 float* const* const* bandOutputs);
+
+private:
+    struct Channel;
+    struct ChannelJob;
+    struct Workers;
+
+    void processChannel(int channel);
+
+    std::vector<std::unique_ptr<Channel>> channels;
+    std::unique_ptr<juce::SharedResourcePointer<Workers>> workers;
+    std::vector<std::unique_ptr<ChannelJob>> jobs; // channels 1..n-1; channel 0 runs on the caller
+
+    double preparedSampleRate = 0.0;
+    int preparedBlockSize = 0;
+    int latencySamples = 0;
+
+    // Arguments of the call in flight, read by the pool jobs
+    const float* const* currentInput = nullptr;
+    float* const* const* currentOutputs = nullptr;
+    int currentNumSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighQualityEngine)
+};
@@ -0,0 +1,143 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "HostBypass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+void HostBypass::prepare(double sampleRate, int maximumBlockSize, int numChannels, int maximumDelay)
+{
+    const int blockSize = std::max(1, maximumBlockSize);
+    primeSamples = (int) std::ceil(primeSeconds * sampleRate);
+    step = (float) (1.0 / std::max(1.0, fadeSeconds * sampleRate));
+
+    // The current block plus whichever reaches further back: the latency or the prime
+    numHistoryChannels = std::max(0, numChannels);
+    capacity = blockSize + std::max(primeSamples, std::max(0, maximumDelay));
+    history.assign((size_t) numHistoryChannels, std::vector<float>((size_t) capacity, 0.0f));
+    writePos = 0;
+    historyLength = 0;
+    lastPushed = 0;
+
+    ramp.assign((size_t) blockSize, mix);
+}
+
+void HostBypass::pushInput(const float* const* input, int numChannels, int numSamples) noexcept
+{
+    if (capacity == 0 || numSamples <= 0)
+        return;
+
+    // Blocks beyond the prepared size: only the newest samples fit
+    const int skipped = std::max(0, numSamples - capacity);
+    const int n = numSamples - skipped;
+    numChannels = std::min(numChannels, numHistoryChannels);
+
+    const int first = std::min(n, capacity - writePos);
+    for (int channel = 0; channel < numHistoryChannels; ++channel)
+    {
+        float* ring = history[(size_t) channel].data();
+        if (channel < numChannels)
+        {
+            std::memcpy(ring + writePos, input[channel] + skipped, sizeof(float) * (size_t) first);
+            std::memcpy(ring, input[channel] + skipped + first, sizeof(float) * (size_t) (n - first));
+        }
+        else
+        {
+            std::fill(ring + writePos, ring + writePos + first, 0.0f);
+            std::fill(ring, ring + (n - first), 0.0f);
+        }
+    }
+
+    writePos = (writePos + n) % capacity;
+    historyLength = std::min(capacity, historyLength + n);
+    lastPushed = n;
+}
+
+HostBypass::Mode HostBypass::update(bool shouldBypass, int numSamples)
+{
+    const float target = shouldBypass ? 0.0f : 1.0f;
+    leavingBypass = (mix == 0.0f && target == 1.0f);
+
+    if (mix == target)
+        return shouldBypass ? bypassed : processing;
+
+    // Hosts stay within the prepared block size; the ramp only grows if one doesn't
+    if ((int) ramp.size() < numSamples)
+        ramp.resize((size_t) numSamples);
+
+    const float delta = shouldBypass ? -step : step;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        mix = std::min(1.0f, std::max(0.0f, mix + delta));
+        ramp[(size_t) i] = mix;
+    }
+
+    return crossfading;
+}
+
+void HostBypass::setBypassed() noexcept
+{
+    mix = 0.0f;
+    leavingBypass = false;
+}
+
+//==============================================================================
+int HostBypass::getPrimeLength() const noexcept
+{
+    return std::max(0, std::min(primeSamples, historyLength - lastPushed));
+}
+
+void HostBypass::readPrime(float* const* destination, int numChannels, int offset, int numSamples) const noexcept
+{
+    const int back = lastPushed + getPrimeLength() - offset;
+    for (int channel = 0; channel < std::min(numChannels, numHistoryChannels); ++channel)
+        read(channel, back, destination[channel], numSamples);
+}
+
+void HostBypass::readDelayed(float* const* destination, int numChannels, int numSamples, int delay) const noexcept
+{
+    numSamples = std::min(numSamples, lastPushed);
+    delay = std::max(0, std::min(delay, capacity - numSamples));
+
+    for (int channel = 0; channel < std::min(numChannels, numHistoryChannels); ++channel)
+        read(channel, numSamples + delay, destination[channel], numSamples);
+}
+
+void HostBypass::read(int channel, int samplesBack, float* destination, int numSamples) const noexcept
+{
+    if (capacity == 0)
+        return;
+
+    const float* ring = history[(size_t) channel].data();
+    const int start = (writePos - samplesBack + capacity) % capacity;
+    const int first = std::min(numSamples, capacity - start);
+
+    std::memcpy(destination, ring + start, sizeof(float) * (size_t) first);
+    std::memcpy(destination + first, ring, sizeof(float) * (size_t) (numSamples - first));
+}
+
+//==============================================================================
+void HostBypass::crossfade(float* const* processed, const float* const* dry, int numChannels, int numSamples) const noexcept
+{
+    numSamples = std::min(numSamples, (int) ramp.size());
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* out = processed[channel];
+        const float* in = dry[channel];
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = in[i] + ramp[(size_t) i] * (out[i] - in[i]);
+    }
+}
+
+void HostBypass::applyFade(float* data, int numSamples) const noexcept
+{
+    numSamples = std::min(numSamples, (int) ramp.size());
+    for (int i = 0; i < numSamples; ++i)
+        data[i] *= ramp[(size_t) i];
+}
@@ -0,0 +1,80 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <vector>
+
+//==============================================================================
+/**
+ * Global bypass: crossfades between the processed and the dry signal, then
+ * lets the processor skip all processing while fully bypassed.
+ *
+ * Keeps a short history of the input, which serves as the dry signal delayed
+ * by the reported latency (so the host's delay compensation still lines up)
+ * and, on the way out of bypass, as material to re-prime the idle processing
+ * chain with before it is faded back in. While bypassed, the cost per block
+ * is one copy of the input into the history.
+ */
+class HostBypass
+{
+public:
+    enum Mode
+    {
+        processing = 0, // fully processed
+        crossfading,    // processed, then crossfaded with the dry signal
+        bypassed        // dry only; nothing else needs to run
+    };
+
+    static constexpr double fadeSeconds = 0.02;
+    static constexpr double primeSeconds = 0.04;
+
+    /** Allocates the history (delays up to maximumDelay samples); nothing is allocated per block. */
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, int maximumDelay);
+
+    /** Appends a block of input to the history; call before update() for each block. */
+    void pushInput(const float* const* input, int numChannels, int numSamples) noexcept;
+
+    /** Moves the crossfade on by numSamples towards the switch; returns how to render the block. */
+    Mode update(bool shouldBypass, int numSamples);
+
+    /** Jumps to fully bypassed (no fade), e.g. for a host that bypasses without the parameter. */
+    void setBypassed() noexcept;
+
+    /** True for the block that starts fading back in from full bypass. */
+    bool isLeavingBypass() const noexcept { return leavingBypass; }
+
+    /** Samples of input available from just before the current block, up to primeSeconds. */
+    int getPrimeLength() const noexcept;
+
+    /** Copies samples [offset, offset + numSamples) of the getPrimeLength() samples before the current block. */
+    void readPrime(float* const* destination, int numChannels, int offset, int numSamples) const noexcept;
+
+    /** Copies the current block's input delayed by 'delay' samples (limited to what the history holds). */
+    void readDelayed(float* const* destination, int numChannels, int numSamples, int delay) const noexcept;
+
+    /** processed = dry + fade * (processed - dry), with the ramp of the last update(). */
+    void crossfade(float* const* processed, const float* const* dry, int numChannels, int numSamples) const noexcept;
+
+    /** Scales a signal that only exists while processing (band buses) by the ramp of the last update(). */
+    void applyFade(float* data, int numSamples) const noexcept;
+
+private:
+    void read(int channel, int samplesBack, float* destination, int numSamples) const noexcept;
+
+    int numHistoryChannels = 0;
+    int capacity = 0;
+    int writePos = 0;
+    int historyLength = 0;  // valid samples in the history
+    int lastPushed = 0;     // size of the current block
+    int primeSamples = 0;
+    std::vector<std::vector<float>> history; // [channel][capacity]
+
+    float mix = 1.0f;       // 1 = processed, 0 = dry
+    float step = 1.0f;      // per sample
+    bool leavingBypass = false;
+    std::vector<float> ramp; // mix per sample of the current block
+};
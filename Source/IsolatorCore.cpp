@@ -0,0 +1,998 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "IsolatorCore.h"
+#include "StageProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #include <xmmintrin.h>
+#endif
+
+namespace
+{
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double inverseRootTwo = 0.70710678118654752440;
+
+    // Second-order sections (Butterworth by default), same arithmetic as juce::dsp::IIR::Coefficients<Type>
+    template <typename Type>
+    std::array<Type, 5> makeLowPass(double sampleRate, float frequency, double q = inverseRootTwo) noexcept
+    {
+        const Type n = Type (1) / std::tan(Type (pi) * Type (frequency) / static_cast<Type>(sampleRate));
+        const Type nSquared = n * n;
+        const Type invQ = Type (1) / Type (q);
+        const Type c1 = Type (1) / (Type (1) + invQ * n + nSquared);
+
+        return { c1, c1 * Type (2), c1, c1 * Type (2) * (Type (1) - nSquared), c1 * (Type (1) - invQ * n + nSquared) };
+    }
+
+    template <typename Type>
+    std::array<Type, 5> makeHighPass(double sampleRate, float frequency, double q = inverseRootTwo) noexcept
+    {
+        const Type n = std::tan(Type (pi) * Type (frequency) / static_cast<Type>(sampleRate));
+        const Type nSquared = n * n;
+        const Type invQ = Type (1) / Type (q);
+        const Type c1 = Type (1) / (Type (1) + invQ * n + nSquared);
+
+        return { c1, c1 * Type (-2), c1, c1 * Type (2) * (nSquared - Type (1)), c1 * (Type (1) - invQ * n + nSquared) };
+    }
+
+    template <typename Type>
+    std::array<Type, 5> makeAllPass(double sampleRate, float frequency, double q) noexcept
+    {
+        const Type n = Type (1) / std::tan(Type (pi) * Type (frequency) / static_cast<Type>(sampleRate));
+        const Type nSquared = n * n;
+        const Type invQ = Type (1) / Type (q);
+        const Type c1 = Type (1) / (Type (1) + invQ * n + nSquared);
+        const Type a1 = c1 * Type (2) * (Type (1) - nSquared);
+        const Type a2 = c1 * (Type (1) - invQ * n + nSquared);
+
+        return { a2, a1, Type (1), a1, a2 };
+    }
+
+    // Two sections per band, in processing order (shared with the response display)
+    template <typename Type>
+    std::array<std::array<Type, 5>, IsolatorCore::numBands * 2> makeSections(double sampleRate, float lowLowMid,
+                                                                             float lowMidMid, float midHigh) noexcept
+    {
+        const auto lowPass = makeLowPass<Type>(sampleRate, lowLowMid);
+        const auto highPass = makeHighPass<Type>(sampleRate, midHigh);
+
+        return { lowPass, lowPass,
+                 makeHighPass<Type>(sampleRate, lowLowMid),
+                 makeLowPass<Type>(sampleRate, lowMidMid),
+                 makeHighPass<Type>(sampleRate, lowMidMid),
+                 makeLowPass<Type>(sampleRate, midHigh),
+                 highPass, highPass };
+    }
+
+    // Q of the two sections of a fourth-order Butterworth: 1 / (2 cos(pi / 8)), 1 / (2 cos(3 pi / 8))
+    constexpr double butterworth4Q[2] = { 0.54119610014619698440, 1.30656296487637652786 };
+
+    // Eighth-order Linkwitz-Riley (a squared fourth-order Butterworth) into 'sections'
+    void addLinkwitzRiley8(IsolatorCore::SteepBandSections& sections, size_t& index, double sampleRate,
+                           float frequency, bool highPass) noexcept
+    {
+        for (int repeat = 0; repeat < 2; ++repeat)
+            for (const double q : butterworth4Q)
+                sections[index++] = highPass ? makeHighPass<double>(sampleRate, frequency, q)
+                                             : makeLowPass<double>(sampleRate, frequency, q);
+    }
+
+    // What the LR8 low and high outputs at 'frequency' sum to: the fourth-order allpass B4(-s) / B4(s)
+    void addCrossoverAllPass(IsolatorCore::SteepBandSections& sections, size_t& index, double sampleRate,
+                             float frequency) noexcept
+    {
+        for (const double q : butterworth4Q)
+            sections[index++] = makeAllPass<double>(sampleRate, frequency, q);
+    }
+
+    float decibelsToGain(float decibels) noexcept
+    {
+        return decibels > -100.0f ? std::pow(10.0f, decibels * 0.05f) : 0.0f;
+    }
+
+    float smoothStep(float x) noexcept
+    {
+        x = std::min(1.0f, std::max(0.0f, x));
+        return x * x * (3.0f - 2.0f * x);
+    }
+
+    // The low band's states reach its output amplified about 40 times, so they must
+    // agree more closely than the signal before a link keeps the step below monoTolerance
+    constexpr float monoStateTolerance = IsolatorCore::monoTolerance / 64.0f;
+
+    // |a - b| <= tolerance over the block; short chunks so stereo content leaves after a few samples
+    bool areWithinTolerance(const float* a, const float* b, int numSamples) noexcept
+    {
+        constexpr int chunk = 32;
+        for (int start = 0; start < numSamples; start += chunk)
+        {
+            const int n = std::min(chunk, numSamples - start);
+            float largest = 0.0f;
+            for (int i = 0; i < n; ++i)
+                largest = std::max(largest, std::abs(a[start + i] - b[start + i]));
+
+            if (! (largest <= IsolatorCore::monoTolerance))
+                return false;
+        }
+        return true;
+    }
+
+    // Flush denormals for the scope (as juce::ScopedNoDenormals): decaying filter
+    // tails would otherwise slow the split down several times over
+    struct ScopedFlushDenormals
+    {
+       #if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+        ScopedFlushDenormals() noexcept : saved(_mm_getcsr()) { _mm_setcsr(saved | 0x8040); } // FTZ | DAZ
+        ~ScopedFlushDenormals() noexcept { _mm_setcsr(saved); }
+        unsigned int saved;
+       #elif defined (__aarch64__) && (defined (__GNUC__) || defined (__clang__))
+        ScopedFlushDenormals() noexcept
+        {
+            __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (saved));
+            const unsigned long long flushToZero = saved | (1ull << 24);
+            __asm__ __volatile__ ("msr fpcr, %0" : : "r" (flushToZero));
+        }
+        ~ScopedFlushDenormals() noexcept { __asm__ __volatile__ ("msr fpcr, %0" : : "r" (saved)); }
+        unsigned long long saved = 0;
+       #endif
+    };
+
+    struct ParameterInfo
+    {
+        const char* id;
+        float minimum, maximum, defaultValue;
+        bool integral;
+    };
+
+    const ParameterInfo parameterInfos[IsolatorCore::numParameters] = {
+        { "low_gain", -100.0f, 24.0f, 0.0f, false }, { "lowmid_gain", -100.0f, 24.0f, 0.0f, false },
+        { "mid_gain", -100.0f, 24.0f, 0.0f, false }, { "high_gain", -100.0f, 24.0f, 0.0f, false },
+        { "low_bypass", 0.0f, 1.0f, 0.0f, true }, { "lowmid_bypass", 0.0f, 1.0f, 0.0f, true },
+        { "mid_bypass", 0.0f, 1.0f, 0.0f, true }, { "high_bypass", 0.0f, 1.0f, 0.0f, true },
+
+        { "low_dyn_mode", 0.0f, 3.0f, 0.0f, true }, { "lowmid_dyn_mode", 0.0f, 3.0f, 0.0f, true },
+        { "mid_dyn_mode", 0.0f, 3.0f, 0.0f, true }, { "high_dyn_mode", 0.0f, 3.0f, 0.0f, true },
+        { "low_dyn_threshold", -60.0f, 0.0f, -20.0f, false }, { "lowmid_dyn_threshold", -60.0f, 0.0f, -20.0f, false },
+        { "mid_dyn_threshold", -60.0f, 0.0f, -20.0f, false }, { "high_dyn_threshold", -60.0f, 0.0f, -20.0f, false },
+        { "low_dyn_ratio", 1.0f, 20.0f, 2.0f, false }, { "lowmid_dyn_ratio", 1.0f, 20.0f, 2.0f, false },
+        { "mid_dyn_ratio", 1.0f, 20.0f, 2.0f, false }, { "high_dyn_ratio", 1.0f, 20.0f, 2.0f, false },
+        { "low_dyn_attack", 0.1f, 200.0f, 30.0f, false }, { "lowmid_dyn_attack", 0.1f, 200.0f, 15.0f, false },
+        { "mid_dyn_attack", 0.1f, 200.0f, 10.0f, false }, { "high_dyn_attack", 0.1f, 200.0f, 5.0f, false },
+        { "low_dyn_release", 5.0f, 2000.0f, 300.0f, false }, { "lowmid_dyn_release", 5.0f, 2000.0f, 200.0f, false },
+        { "mid_dyn_release", 5.0f, 2000.0f, 150.0f, false }, { "high_dyn_release", 5.0f, 2000.0f, 100.0f, false },
+        { "dyn_range", 0.0f, 80.0f, 40.0f, false },
+
+        { "stereo_mode", 0.0f, 1.0f, 0.0f, true },
+        { "low_side_gain", -100.0f, 24.0f, 0.0f, false }, { "lowmid_side_gain", -100.0f, 24.0f, 0.0f, false },
+        { "mid_side_gain", -100.0f, 24.0f, 0.0f, false }, { "high_side_gain", -100.0f, 24.0f, 0.0f, false },
+        { "low_side_bypass", 0.0f, 1.0f, 0.0f, true }, { "lowmid_side_bypass", 0.0f, 1.0f, 0.0f, true },
+        { "mid_side_bypass", 0.0f, 1.0f, 0.0f, true }, { "high_side_bypass", 0.0f, 1.0f, 0.0f, true }
+    };
+
+    // dB to log2 units (the dynamics kernel's level domain)
+    constexpr float log2PerDecibel = 0.16609640474436813f;
+
+    // Reduced slope tier, stepping back up: how long the Low/High second section runs
+    // again before it is faded in (its slowest time constant is about 1 ms at 200 Hz)
+    constexpr double slopeWarmupSeconds = 0.01;
+
+    // Ramp times per band (ms): gain, then bypass. Low is slowest to avoid zipper noise and pops.
+    constexpr float gainRampMs[IsolatorCore::numBands]   = { 160.0f, 15.0f, 12.0f, 10.0f };
+    constexpr float bypassRampMs[IsolatorCore::numBands] = { 80.0f, 50.0f, 40.0f, 25.0f };
+}
+
+//==============================================================================
+IsolatorCore::BandSections IsolatorCore::designSections(double sampleRate, float lowLowMid, float lowMidMid, float midHigh)
+{
+    return makeSections<float>(sampleRate, lowLowMid, lowMidMid, midHigh);
+}
+
+IsolatorCore::SteepBandSections IsolatorCore::designSteepSections(double sampleRate, float lowLowMid, float lowMidMid, float midHigh)
+{
+    // Split at Low-Mid | Mid first; each half then splits again and takes the allpass of the
+    // other half's crossover, so Low + Low-Mid and Mid + High share the same phase
+    SteepBandSections sections;
+    size_t index = 0;
+
+    addLinkwitzRiley8(sections, index, sampleRate, lowLowMid, false);
+    addLinkwitzRiley8(sections, index, sampleRate, lowMidMid, false);
+    addCrossoverAllPass(sections, index, sampleRate, midHigh);
+
+    addLinkwitzRiley8(sections, index, sampleRate, lowLowMid, true);
+    addLinkwitzRiley8(sections, index, sampleRate, lowMidMid, false);
+    addCrossoverAllPass(sections, index, sampleRate, midHigh);
+
+    addLinkwitzRiley8(sections, index, sampleRate, lowMidMid, true);
+    addLinkwitzRiley8(sections, index, sampleRate, midHigh, false);
+    addCrossoverAllPass(sections, index, sampleRate, lowLowMid);
+
+    addLinkwitzRiley8(sections, index, sampleRate, lowMidMid, true);
+    addLinkwitzRiley8(sections, index, sampleRate, midHigh, true);
+    addCrossoverAllPass(sections, index, sampleRate, lowLowMid);
+
+    return sections;
+}
+
+const char* IsolatorCore::getParameterId(Parameter parameter) noexcept
+{
+    return parameterInfos[(size_t) parameter].id;
+}
+
+float IsolatorCore::getParameterDefault(Parameter parameter) noexcept
+{
+    return parameterInfos[(size_t) parameter].defaultValue;
+}
+
+IsolatorCore::IsolatorCore()
+{
+    for (int i = 0; i < numParameters; ++i)
+        parameters[(size_t) i] = parameterInfos[i].defaultValue;
+
+    for (int band = 0; band < numBands; ++band)
+        bandOutputs[(size_t) band] = bandPointers[(size_t) band].data();
+}
+
+//==============================================================================
+void IsolatorCore::prepare(double sampleRate, int maximumBlockSize, int numChannels)
+{
+    numChannels = std::max(0, std::min(numChannels, maxChannels));
+    const bool sampleRateChanged = (sampleRate != preparedSampleRate);
+    const bool channelsChanged = (numChannels != preparedNumChannels);
+
+    preparedSampleRate = sampleRate;
+    preparedNumChannels = numChannels;
+
+    if (channelsChanged)
+    {
+        constexpr int pairSize = DspKernels::SplitState::maxChannels;
+        splitters.resize((size_t) ((numChannels + pairSize - 1) / pairSize));
+        splitScratch.resize((size_t) (scratchFrames * DspKernels::SplitState::maxLanes));
+
+        for (auto& splitter : splitters)
+        {
+            splitter.scratch = splitScratch.data();
+            splitter.scratchFrames = scratchFrames;
+            splitter.setSlopeBand(0, true); // Low and High carry the second section the slope tier drops
+            splitter.setSlopeBand(3, true);
+            splitter.upperBandsOnly = upperBandsOnly;
+        }
+    }
+
+    if (sampleRateChanged)
+    {
+        // DC blocker for low band (simple 1st-order high-pass at ~5 Hz), r = exp(-2*pi*fc/fs)
+        const double fc = 5.0;
+        dcBlockerR = (float) std::exp(-2.0 * 3.14159265358979323846 * fc / sampleRate);
+        seedSmoothers();
+        dynamicsDirty = true;
+    }
+
+    if (sampleRateChanged || channelsChanged)
+    {
+        applySections(designSections(sampleRate, crossovers[0], crossovers[1], crossovers[2]));
+
+        // A channel pair shares a splitter, so a layout change can't keep per-channel state
+        for (auto& splitter : splitters)
+            splitter.reset();
+
+        // Cleared state belongs to neither domain: take the stereo mode as it stands
+        midSideActive = wantsMidSide();
+        for (int band = 0; band < numBands; ++band)
+        {
+            sideGainSmoothers[(size_t) band].setCurrentAndTargetValue(parameters[(size_t) (lowSideGain + band)]);
+            sideBypassSmoothers[(size_t) band].setCurrentAndTargetValue(parameters[(size_t) (lowSideBypass + band)] > 0.0f ? 0.0f : 1.0f);
+        }
+    }
+
+    preparedBlockSize = std::max(maximumBlockSize, preparedBlockSize);
+    growBuffers(preparedBlockSize);
+}
+
+void IsolatorCore::reset() noexcept
+{
+    resetSplit();
+    dynamics.reset();
+}
+
+void IsolatorCore::resetSplit() noexcept
+{
+    for (auto& splitter : splitters)
+        splitter.reset();
+}
+
+void IsolatorCore::process(float* const* channels, int numChannels, int numSamples)
+{
+    numChannels = std::min(numChannels, preparedNumChannels);
+    if (numChannels <= 0 || numSamples <= 0 || (isNeutral() && analyzer == nullptr))
+        return;
+
+    const ScopedFlushDenormals flushDenormals;
+    const int chunk = std::max(1, preparedBlockSize);
+    for (int start = 0; start < numSamples; start += chunk)
+    {
+        const int n = std::min(chunk, numSamples - start);
+
+        float* chunkChannels[maxChannels] = {};
+        for (int channel = 0; channel < numChannels; ++channel)
+            chunkChannels[channel] = channels[channel] + start;
+
+        computeControlCurves(n);
+
+        // Mid/side is encoded in place, unless the channels must come out untouched
+        const bool measureOnly = analyzer != nullptr && analyzeOnly;
+        if (midSideActive && numChannels >= 2 && ! measureOnly)
+            encodeMidSide(chunkChannels[0], chunkChannels[1], n);
+
+        splitBands(chunkChannels, numChannels, n);
+
+        if (analyzer != nullptr)
+        {
+            analyzeBands(*analyzer, numChannels, n);
+            if (analyzeOnly)
+                continue;
+        }
+
+        applyDynamics(numChannels, n);
+        mixBands(chunkChannels, numChannels, n);
+    }
+}
+
+void IsolatorCore::setAnalyzer(BandAnalyzer* analyzerToUse, bool analysisOnly) noexcept
+{
+    analyzer = analyzerToUse;
+    analyzeOnly = analysisOnly;
+}
+
+//==============================================================================
+void IsolatorCore::setParameter(Parameter parameter, float value) noexcept
+{
+    const auto& info = parameterInfos[(size_t) parameter];
+    value = std::min(info.maximum, std::max(info.minimum, value));
+    if (info.integral)
+        value = std::floor(value + 0.5f);
+
+    auto& stored = parameters[(size_t) parameter];
+    if (parameter >= lowDynamicsMode && parameter <= dynamicsRange && value != stored)
+        dynamicsDirty = true;
+    stored = value;
+}
+
+bool IsolatorCore::isNeutral() const noexcept
+{
+    for (int i = lowGain; i <= highBypass; ++i)
+        if (parameters[(size_t) i] != 0.0f)
+            return false;
+
+    // Side gains only count in mid/side (or while the side set ramps back to the mid one)
+    if (wantsMidSide() || midSideActive)
+        for (int i = lowSideGain; i <= highSideBypass; ++i)
+            if (parameters[(size_t) i] != 0.0f)
+                return false;
+
+    return ! isDynamicsRunning();
+}
+
+std::string IsolatorCore::getState() const
+{
+    std::string state;
+    char line[64];
+    for (int i = 0; i < numParameters; ++i)
+    {
+        std::snprintf(line, sizeof(line), "%s=%.9g\n", parameterInfos[i].id, (double) parameters[(size_t) i]);
+        state += line;
+    }
+    return state;
+}
+
+bool IsolatorCore::setState(const std::string& state)
+{
+    bool anyRestored = false;
+    size_t lineStart = 0;
+
+    while (lineStart < state.size())
+    {
+        size_t lineEnd = state.find('\n', lineStart);
+        if (lineEnd == std::string::npos)
+            lineEnd = state.size();
+
+        const std::string line = state.substr(lineStart, lineEnd - lineStart);
+        const size_t equals = line.find('=');
+
+        if (equals != std::string::npos)
+        {
+            const std::string key = line.substr(0, equals);
+            const char* valueText = line.c_str() + equals + 1;
+            char* parsedEnd = nullptr;
+            const float value = std::strtof(valueText, &parsedEnd);
+
+            for (int i = 0; i < numParameters && parsedEnd != valueText; ++i)
+            {
+                if (key == parameterInfos[i].id)
+                {
+                    setParameter((Parameter) i, value);
+                    anyRestored = true;
+                }
+            }
+        }
+
+        lineStart = lineEnd + 1;
+    }
+
+    return anyRestored;
+}
+
+//==============================================================================
+void IsolatorCore::computeControlCurves(int numSamples)
+{
+    EQ4_PROFILE_SCOPE("control curves");
+    growBuffers(numSamples);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        // Smooth in dB domain (less sensitivity around 0 dB)
+        gainSmoothers[(size_t) band].setTargetValue(parameters[(size_t) (lowGain + band)]);
+        bypassSmoothers[(size_t) band].setTargetValue(parameters[(size_t) (lowBypass + band)] > 0.0f ? 0.0f : 1.0f);
+    }
+
+    // Mid/side starts with the side set exactly where the mid one is (same output as
+    // left/right) and ramps from there; switched off, the side set ramps back first
+    const bool wantMidSide = wantsMidSide();
+    if (wantMidSide && ! midSideActive)
+    {
+        sideGainSmoothers = gainSmoothers;
+        sideBypassSmoothers = bypassSmoothers;
+        splitters.front().encodeMidSideState();
+        midSideActive = true;
+    }
+
+    if (midSideActive)
+    {
+        for (int band = 0; band < numBands; ++band)
+        {
+            const int gain = wantMidSide ? lowSideGain + band : lowGain + band;
+            const int bypass = wantMidSide ? lowSideBypass + band : lowBypass + band;
+            sideGainSmoothers[(size_t) band].setTargetValue(parameters[(size_t) gain]);
+            sideBypassSmoothers[(size_t) band].setTargetValue(parameters[(size_t) bypass] > 0.0f ? 0.0f : 1.0f);
+        }
+    }
+
+    if (coarseControl)
+    {
+        // Evaluate the curves every few samples and interpolate linearly.
+        // Same smoothers, same end points, so switching resolution is seamless.
+        auto fillCoarse = [numSamples](LinearSmoother& smoother, float* curve, float (*map)(float) noexcept)
+        {
+            // Settled: one value for the whole block, as on the full-resolution path
+            if (! smoother.isSmoothing())
+            {
+                std::fill(curve, curve + numSamples, map(smoother.getNextValue()));
+                return;
+            }
+
+            constexpr int step = 16;
+            float previous = map(smoother.getCurrentValue());
+            for (int start = 0; start < numSamples; start += step)
+            {
+                const int n = std::min(step, numSamples - start);
+                const float next = map(smoother.skip(n));
+                const float increment = (next - previous) / (float) n;
+                for (int j = 0; j < n; ++j)
+                    curve[start + j] = previous + increment * (float) (j + 1);
+                previous = next;
+            }
+        };
+
+        for (int band = 0; band < numBands; ++band)
+            fillCoarse(gainSmoothers[(size_t) band], gainCurves[(size_t) band].data(), decibelsToGain);
+        for (int band = 0; band < numBands; ++band)
+            fillCoarse(bypassSmoothers[(size_t) band], bypassCurves[(size_t) band].data(), smoothStep);
+
+        for (int band = 0; band < numBands && midSideActive; ++band)
+        {
+            fillCoarse(sideGainSmoothers[(size_t) band], sideGainCurves[(size_t) band].data(), decibelsToGain);
+            fillCoarse(sideBypassSmoothers[(size_t) band], sideBypassCurves[(size_t) band].data(), smoothStep);
+        }
+    }
+    else
+    {
+        // Settled smoothers give the same value every sample: map it once
+        auto fill = [numSamples](LinearSmoother& smoother, float* curve, float (*map)(float) noexcept)
+        {
+            if (smoother.isSmoothing())
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    curve[i] = map(smoother.getNextValue());
+            }
+            else
+            {
+                std::fill(curve, curve + numSamples, map(smoother.getNextValue()));
+            }
+        };
+
+        for (int band = 0; band < numBands; ++band)
+            fill(gainSmoothers[(size_t) band], gainCurves[(size_t) band].data(), decibelsToGain);
+        for (int band = 0; band < numBands; ++band)
+            fill(bypassSmoothers[(size_t) band], bypassCurves[(size_t) band].data(), smoothStep);
+
+        for (int band = 0; band < numBands && midSideActive; ++band)
+        {
+            fill(sideGainSmoothers[(size_t) band], sideGainCurves[(size_t) band].data(), decibelsToGain);
+            fill(sideBypassSmoothers[(size_t) band], sideBypassCurves[(size_t) band].data(), smoothStep);
+        }
+    }
+
+    // Back to left/right once the side set has caught up: from the next block on the two are equal
+    if (midSideActive && ! wantMidSide && sideMatchesMid())
+    {
+        splitters.front().decodeMidSideState();
+        midSideActive = false;
+    }
+
+    // Slope order crossfade (1 = full order, 0 = single section on Low/High). Settled at 0,
+    // the kernel skips the second section; on the way back it first runs from a clear
+    // state at zero weight, so what is faded in has settled.
+    if (reducedSlopes)
+    {
+        slopeWarmupRemaining = 0;
+        slopeSmoother.setTargetValue(0.0f);
+    }
+    else
+    {
+        if (slopeSectionsSkipped)
+        {
+            for (auto& splitter : splitters)
+                splitter.clearSlopeSections();
+            slopeWarmupRemaining = (int) std::ceil(slopeWarmupSeconds * preparedSampleRate);
+        }
+
+        if (slopeWarmupRemaining > 0)
+            slopeWarmupRemaining = std::max(0, slopeWarmupRemaining - numSamples);
+        else
+            slopeSmoother.setTargetValue(1.0f);
+    }
+
+    slopeBlend = nullptr;
+    if (slopeSmoother.isSmoothing())
+    {
+        for (int i = 0; i < numSamples; ++i)
+            slopeCurve[(size_t) i] = slopeSmoother.getNextValue();
+        slopeBlend = slopeCurve.data();
+    }
+
+    slopeSectionsSkipped = reducedSlopes && ! slopeSmoother.isSmoothing();
+    for (auto& splitter : splitters)
+        splitter.skipSlopeSections = slopeSectionsSkipped;
+}
+
+void IsolatorCore::splitBands(const float* const* inputs, int numChannels, int numSamples)
+{
+    // All band filter chains and the DC blocker run fused in one kernel pass per channel pair
+    EQ4_PROFILE_SCOPE("band split");
+    const auto& kernels = DspKernels::get();
+    constexpr int pairSize = DspKernels::SplitState::maxChannels;
+    numChannels = std::min(numChannels, preparedNumChannels);
+
+    bool allLinked = numChannels > 0;
+
+    for (int first = 0; first < numChannels; first += pairSize)
+    {
+        auto& splitter = splitters[(size_t) (first / pairSize)];
+        float* const* const pairOutputs[numBands] = { bandOutputs[0] + first, bandOutputs[1] + first,
+                                                      bandOutputs[2] + first, bandOutputs[3] + first };
+        const int pairChannels = std::min(pairSize, numChannels - first);
+
+        // Dual mono: both channels would come out the same, so split one and copy (the
+        // kernel gives a channel the same bits alone as in a pair, so this is exact). The
+        // states must match too, or overwriting the second would cut the tail of
+        // earlier stereo content; they converge once that tail has died away.
+        const bool linked = monoDetection && pairChannels == 2
+                         && splitter.getChannelStateDifference() <= monoStateTolerance
+                         && areWithinTolerance(inputs[first], inputs[first + 1], numSamples);
+
+        kernels.splitBands(splitter, inputs + first, linked ? 1 : pairChannels,
+                           pairOutputs, numSamples, slopeBlend, slopeSmoother.getCurrentValue());
+
+        if (linked)
+        {
+            splitter.copyFirstChannelState();
+            for (int band = upperBandsOnly ? numBands / 2 : 0; band < numBands; ++band)
+                std::memcpy(pairOutputs[band][1], pairOutputs[band][0], sizeof(float) * (size_t) numSamples);
+        }
+
+        allLinked = allLinked && linked;
+    }
+
+    lastSplitLinked = allLinked;
+}
+
+void IsolatorCore::setUpperBandsOnly(bool shouldSplitUpperOnly) noexcept
+{
+    if (shouldSplitUpperOnly == upperBandsOnly)
+        return;
+
+    // Cleared on the way in too, so the idle lanes of a pair match and don't block the mono link
+    upperBandsOnly = shouldSplitUpperOnly;
+    for (auto& splitter : splitters)
+    {
+        splitter.clearLowerBands();
+        splitter.upperBandsOnly = upperBandsOnly;
+    }
+}
+
+void IsolatorCore::encodeMidSide(float* left, float* right, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float l = left[i];
+        const float r = right[i];
+        left[i] = 0.5f * (l + r);
+        right[i] = 0.5f * (l - r);
+    }
+}
+
+void IsolatorCore::setCrossovers(float lowLowMid, float lowMidMid, float midHigh)
+{
+    crossovers = { lowLowMid, lowMidMid, midHigh };
+    if (preparedSampleRate > 0.0)
+        applySections(designSections(preparedSampleRate, lowLowMid, lowMidMid, midHigh));
+}
+
+void IsolatorCore::applyDynamics(int numChannels, int numSamples) noexcept
+{
+    if (! isDynamicsRunning())
+    {
+        dynamics.reset(); // drop the inaudible remainder of the last release
+        return;
+    }
+
+    EQ4_PROFILE_SCOPE("band dynamics");
+
+    if (dynamicsDirty)
+        updateDynamics();
+
+    const auto& kernels = DspKernels::get();
+    numChannels = std::min(numChannels, preparedNumChannels);
+    if (numChannels <= 0 || numSamples <= 0)
+        return;
+
+    // Linked peak level per band, then all four detectors in one pass straight into the gain curves
+    // (mid/side: detected on both, the same gain change on both curves)
+    float* detectors[numBands] = {};
+    float* gains[numBands] = {};
+    float* sideGains[numBands] = {};
+    for (int band = 0; band < numBands; ++band)
+    {
+        detectors[band] = detectorStorage.data() + (size_t) (band * bandCapacity);
+        for (int channel = 0; channel < numChannels; ++channel)
+            kernels.absMax(detectors[band], bandPointers[(size_t) band][(size_t) channel], numSamples, channel > 0);
+        gains[band] = gainCurves[(size_t) band].data();
+        sideGains[band] = sideGainCurves[(size_t) band].data();
+    }
+
+    kernels.bandDynamics(dynamics, detectors, gains, midSideActive ? sideGains : nullptr, numSamples);
+}
+
+void IsolatorCore::analyzeBands(BandAnalyzer& bandAnalyzer, int numChannels, int numSamples) const noexcept
+{
+    EQ4_PROFILE_SCOPE("band analysis");
+    bandAnalyzer.process(bandOutputs.data(), std::min(numChannels, preparedNumChannels), numSamples);
+}
+
+float IsolatorCore::getGainChangeDecibels(int band) const noexcept
+{
+    return dynamics.gainChange[band] / log2PerDecibel;
+}
+
+void IsolatorCore::applyBandGains(int numChannels, int numSamples) noexcept
+{
+    EQ4_PROFILE_SCOPE("band gains");
+    const auto& kernels = DspKernels::get();
+    numChannels = std::min(numChannels, preparedNumChannels);
+
+    // Mid/side: the first pair gets its own gains and the decode in one pass
+    const int firstChannel = (midSideActive && numChannels >= 2) ? 2 : 0;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if (firstChannel == 2)
+        {
+            float* mid = bandPointers[(size_t) band][0];
+            float* side = bandPointers[(size_t) band][1];
+            const float* gain = gainCurves[(size_t) band].data();
+            const float* bypass = bypassCurves[(size_t) band].data();
+            const float* sideGain = sideGainCurves[(size_t) band].data();
+            const float* sideBypass = sideBypassCurves[(size_t) band].data();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float m = mid[i] * gain[i] * bypass[i];
+                const float s = side[i] * sideGain[i] * sideBypass[i];
+                mid[i] = m + s;
+                side[i] = m - s;
+            }
+        }
+
+        for (int channel = firstChannel; channel < numChannels; ++channel)
+            kernels.applyGain(bandPointers[(size_t) band][(size_t) channel],
+                              gainCurves[(size_t) band].data(), bypassCurves[(size_t) band].data(), numSamples);
+    }
+}
+
+void IsolatorCore::mixBands(float* const* outputs, int numChannels, int numSamples) const noexcept
+{
+    EQ4_PROFILE_SCOPE("mix");
+    const auto& kernels = DspKernels::get();
+    numChannels = std::min(numChannels, preparedNumChannels);
+
+    const float* const gains[numBands]    = { gainCurves[0].data(), gainCurves[1].data(), gainCurves[2].data(), gainCurves[3].data() };
+    const float* const bypasses[numBands] = { bypassCurves[0].data(), bypassCurves[1].data(), bypassCurves[2].data(), bypassCurves[3].data() };
+
+    int firstChannel = 0;
+    if (midSideActive && numChannels >= 2)
+    {
+        const float* const sideGains[numBands]    = { sideGainCurves[0].data(), sideGainCurves[1].data(),
+                                                      sideGainCurves[2].data(), sideGainCurves[3].data() };
+        const float* const sideBypasses[numBands] = { sideBypassCurves[0].data(), sideBypassCurves[1].data(),
+                                                      sideBypassCurves[2].data(), sideBypassCurves[3].data() };
+        const float* const mids[numBands]  = { bandPointers[0][0], bandPointers[1][0], bandPointers[2][0], bandPointers[3][0] };
+        const float* const sides[numBands] = { bandPointers[0][1], bandPointers[1][1], bandPointers[2][1], bandPointers[3][1] };
+
+        kernels.mixBandsMidSide(outputs[0], outputs[1], mids, gains, bypasses, sides, sideGains, sideBypasses, numSamples);
+        firstChannel = 2;
+    }
+
+    for (int channel = firstChannel; channel < numChannels; ++channel)
+    {
+        const float* const bands[numBands] = { bandPointers[0][(size_t) channel], bandPointers[1][(size_t) channel],
+                                               bandPointers[2][(size_t) channel], bandPointers[3][(size_t) channel] };
+        kernels.mixBands(outputs[channel], bands, gains, bypasses, numSamples);
+    }
+}
+
+void IsolatorCore::renderBand(int band, float* const* outputs, int numChannels, int numSamples, bool alreadyGained) const noexcept
+{
+    const auto& kernels = DspKernels::get();
+    numChannels = std::min(numChannels, preparedNumChannels);
+    const float* gain = gainCurves[(size_t) band].data();
+    const float* bypass = bypassCurves[(size_t) band].data();
+
+    int firstChannel = 0;
+    if (midSideActive && numChannels >= 2 && ! alreadyGained)
+    {
+        const float* mid = bandPointers[(size_t) band][0];
+        const float* side = bandPointers[(size_t) band][1];
+        const float* sideGain = sideGainCurves[(size_t) band].data();
+        const float* sideBypass = sideBypassCurves[(size_t) band].data();
+        float* left = outputs[0];
+        float* right = outputs[1];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float m = mid[i] * gain[i] * bypass[i];
+            const float s = side[i] * sideGain[i] * sideBypass[i];
+            left[i] = m + s;
+            right[i] = m - s;
+        }
+        firstChannel = 2;
+    }
+
+    for (int channel = firstChannel; channel < numChannels; ++channel)
+    {
+        std::memcpy(outputs[channel], bandPointers[(size_t) band][(size_t) channel], sizeof(float) * (size_t) numSamples);
+        if (! alreadyGained)
+            kernels.applyGain(outputs[channel], gain, bypass, numSamples);
+    }
+}
+
+void IsolatorCore::sumBands(float* const* outputs, int numChannels, int numSamples) const noexcept
+{
+    EQ4_PROFILE_SCOPE("band sum");
+    numChannels = std::min(numChannels, preparedNumChannels);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const float* low = bandPointers[0][(size_t) channel];
+        const float* lowMid = bandPointers[1][(size_t) channel];
+        const float* mid = bandPointers[2][(size_t) channel];
+        const float* high = bandPointers[3][(size_t) channel];
+        float* output = outputs[channel];
+
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = low[i] + lowMid[i] + mid[i] + high[i];
+    }
+}
+
+//==============================================================================
+void IsolatorCore::growBuffers(int numSamples)
+{
+    if (numSamples <= bandCapacity && bandLayoutChannels == preparedNumChannels)
+        return;
+
+    bandCapacity = std::max(numSamples, bandCapacity);
+    bandLayoutChannels = preparedNumChannels;
+    bandStorage.assign((size_t) (numBands * std::max(1, preparedNumChannels) * bandCapacity), 0.0f);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        for (int channel = 0; channel < maxChannels; ++channel)
+        {
+            bandPointers[(size_t) band][(size_t) channel] = channel < preparedNumChannels
+                ? bandStorage.data() + (size_t) ((band * preparedNumChannels + channel) * bandCapacity)
+                : nullptr;
+        }
+    }
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        gainCurves[(size_t) band].resize((size_t) bandCapacity, 1.0f);
+        bypassCurves[(size_t) band].resize((size_t) bandCapacity, 1.0f);
+        sideGainCurves[(size_t) band].resize((size_t) bandCapacity, 1.0f);
+        sideBypassCurves[(size_t) band].resize((size_t) bandCapacity, 1.0f);
+    }
+    slopeCurve.resize((size_t) bandCapacity, 1.0f);
+    detectorStorage.resize((size_t) (numBands * bandCapacity));
+}
+
+void IsolatorCore::applySections(const BandSections& sections)
+{
+    for (auto& splitter : splitters)
+    {
+        for (int band = 0; band < numBands; ++band)
+            splitter.setBand(band, sections[(size_t) (band * 2)].data(), sections[(size_t) (band * 2 + 1)].data());
+        splitter.setDcBlocker(0, dcBlockerR);
+    }
+}
+
+void IsolatorCore::seedSmoothers() noexcept
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto& gain = gainSmoothers[(size_t) band];
+        gain.reset(preparedSampleRate, gainRampMs[band] / 1000.0f);
+        gain.setCurrentAndTargetValue(parameters[(size_t) (lowGain + band)]);
+
+        auto& bypass = bypassSmoothers[(size_t) band];
+        bypass.reset(preparedSampleRate, bypassRampMs[band] / 1000.0f);
+        bypass.setCurrentAndTargetValue(parameters[(size_t) (lowBypass + band)] > 0.0f ? 0.0f : 1.0f);
+
+        // Values set where the mode is decided (prepare), ramp lengths as the mid set
+        sideGainSmoothers[(size_t) band].reset(preparedSampleRate, gainRampMs[band] / 1000.0f);
+        sideBypassSmoothers[(size_t) band].reset(preparedSampleRate, bypassRampMs[band] / 1000.0f);
+    }
+
+    slopeSmoother.reset(preparedSampleRate, 0.02);
+    slopeSmoother.setCurrentAndTargetValue(1.0f);
+    slopeSectionsSkipped = false;
+    slopeWarmupRemaining = 0;
+}
+
+void IsolatorCore::updateDynamics() noexcept
+{
+    if (preparedSampleRate <= 0.0)
+        return;
+
+    const float range = -parameters[dynamicsRange] * log2PerDecibel;
+    auto timeCoefficient = [this](float milliseconds)
+    {
+        return (float) std::exp(-1.0 / (milliseconds * 0.001 * preparedSampleRate));
+    };
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const int mode = (int) parameters[(size_t) (lowDynamicsMode + band)];
+        const float ratio = parameters[(size_t) (lowRatio + band)];
+
+        dynamics.threshold[band] = parameters[(size_t) (lowThreshold + band)] * log2PerDecibel;
+        dynamics.slopeAbove[band] = mode == dynamicsCompressor ? 1.0f / ratio - 1.0f : 0.0f;
+        dynamics.slopeBelow[band] = mode == dynamicsExpander ? ratio - 1.0f
+                                  : (mode == dynamicsGate ? 100.0f : 0.0f);
+        dynamics.floor[band] = (mode == dynamicsExpander || mode == dynamicsGate) ? range
+                             : (mode == dynamicsCompressor ? -20.0f : 0.0f);
+        // Compressors attack as the gain falls; expanders and gates attack as they open
+        const float attack = timeCoefficient(parameters[(size_t) (lowAttack + band)]);
+        const float release = timeCoefficient(parameters[(size_t) (lowRelease + band)]);
+        const bool opensOnAttack = (mode == dynamicsExpander || mode == dynamicsGate);
+        dynamics.fallCoefficient[band] = opensOnAttack ? release : attack;
+        dynamics.riseCoefficient[band] = opensOnAttack ? attack : release;
+    }
+
+    dynamicsDirty = false;
+}
+
+bool IsolatorCore::wantsMidSide() const noexcept
+{
+    return parameters[stereoMode] == (float) stereoMidSide && preparedNumChannels >= 2;
+}
+
+bool IsolatorCore::sideMatchesMid() const noexcept
+{
+    auto settledOn = [](const LinearSmoother& a, const LinearSmoother& b)
+    {
+        return ! a.isSmoothing() && ! b.isSmoothing() && a.getCurrentValue() == b.getCurrentValue();
+    };
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if (! settledOn(sideGainSmoothers[(size_t) band], gainSmoothers[(size_t) band])
+            || ! settledOn(sideBypassSmoothers[(size_t) band], bypassSmoothers[(size_t) band]))
+            return false;
+    }
+    return true;
+}
+
+bool IsolatorCore::isDynamicsRunning() const noexcept
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        if (parameters[(size_t) (lowDynamicsMode + band)] != (float) dynamicsOff
+            || std::abs(dynamics.gainChange[band]) > 1.0e-6f)
+            return true;
+    }
+    return false;
+}
+
+//==============================================================================
+void IsolatorCore::LinearSmoother::reset(double sampleRate, double rampSeconds) noexcept
+{
+    stepsToTarget = (int) std::floor(rampSeconds * sampleRate);
+    setCurrentAndTargetValue(target);
+}
+
+void IsolatorCore::LinearSmoother::setCurrentAndTargetValue(float value) noexcept
+{
+    current = target = value;
+    countdown = 0;
+}
+
+void IsolatorCore::LinearSmoother::setTargetValue(float value) noexcept
+{
+    if (value == target)
+        return;
+
+    if (stepsToTarget <= 0)
+    {
+        setCurrentAndTargetValue(value);
+        return;
+    }
+
+    target = value;
+    countdown = stepsToTarget;
+    step = (target - current) / (float) countdown;
+}
+
+float IsolatorCore::LinearSmoother::getNextValue() noexcept
+{
+    if (! isSmoothing())
+        return target;
+
+    --countdown;
+    if (isSmoothing())
+        current += step;
+    else
+        current = target;
+
+    return current;
+}
+
+float IsolatorCore::LinearSmoother::skip(int numSamples) noexcept
+{
+    if (numSamples >= countdown)
+    {
+        setCurrentAndTargetValue(target);
+        return target;
+    }
+
+    current += step * (float) numSamples;
+    countdown -= numSamples;
+    return current;
+}
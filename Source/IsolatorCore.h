@@ -0,0 +1,294 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include "BandAnalyzer.h"
+#include "DspKernels.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+//==============================================================================
+/**
+ * The isolator's band-split / gain engine, free of JUCE so it can run in a
+ * headless process (the EQIsolator4Core library target).
+ *
+ * Minimal use: prepare(), setParameter() or setState(), then process() on
+ * planar float channels in place. The plugin drives the same object through
+ * the stage functions (control curves, split, gain, mix) so it can put the
+ * offline engine, multirate branch, limiters and band buses in between;
+ * process() is just those stages in order, so both paths run the same code.
+ *
+ * Allocates in prepare() and setState() only, plus growing the band buffers
+ * if a block ever exceeds the prepared size.
+ */
+class IsolatorCore
+{
+public:
+    static constexpr int numBands = DspKernels::SplitState::bandsPerChannel;
+    static constexpr int maxChannels = 8;
+
+    enum Parameter
+    {
+        lowGain = 0, lowMidGain, midGain, highGain,         // dB, -100 (silence) to +24
+        lowBypass, lowMidBypass, midBypass, highBypass,     // 0 or 1
+
+        // Per-band dynamics on the split bands, before the band gain
+        lowDynamicsMode, lowMidDynamicsMode, midDynamicsMode, highDynamicsMode, // DynamicsMode
+        lowThreshold, lowMidThreshold, midThreshold, highThreshold,             // dB, -60 to 0
+        lowRatio, lowMidRatio, midRatio, highRatio,                             // 1 to 20
+        lowAttack, lowMidAttack, midAttack, highAttack,                         // ms, 0.1 to 200
+        lowRelease, lowMidRelease, midRelease, highRelease,                     // ms, 5 to 2000
+        dynamicsRange,                                                          // dB, deepest expander/gate cut (0 to 80)
+
+        // Mid/side on channels 0 and 1: the band gains and bypasses above then act on the mid signal
+        stereoMode,                                                             // StereoMode
+        lowSideGain, lowMidSideGain, midSideGain, highSideGain,                 // dB, -100 (silence) to +24
+        lowSideBypass, lowMidSideBypass, midSideBypass, highSideBypass,         // 0 or 1
+        numParameters
+    };
+
+    enum DynamicsMode
+    {
+        dynamicsOff = 0,
+        dynamicsCompressor,   // downward above the threshold
+        dynamicsExpander,     // downward below the threshold, down to the range
+        dynamicsGate,         // the range below the threshold
+        numDynamicsModes
+    };
+
+    enum StereoMode
+    {
+        stereoLeftRight = 0,
+        stereoMidSide,        // split (L + R) / 2 and (L - R) / 2, decoded in the mix
+        numStereoModes
+    };
+
+    // Default crossover points (Hz): Low | Low-Mid | Mid | High
+    static constexpr float defaultLowLowMidCrossover = 200.0f;
+    static constexpr float defaultLowMidMidCrossover = 750.0f;
+    static constexpr float defaultMidHighCrossover = 3000.0f;
+
+    /** Raw normalised (b0 b1 b2 a1 a2) coefficients of the two sections of each band. */
+    using Section = std::array<float, 5>;
+    using BandSections = std::array<Section, numBands * 2>;
+    static BandSections designSections(double sampleRate,
+                                       float lowLowMid = defaultLowLowMidCrossover,
+                                       float lowMidMid = defaultLowMidMidCrossover,
+                                       float midHigh = defaultMidHighCrossover);
+
+    /** Offline engine sections, in double: eighth-order Linkwitz-Riley crossovers in a tree
+        with allpass compensation, so the four bands sum to an allpass (flat magnitude). */
+    static constexpr int steepSectionsPerBand = 10;
+    using SteepBandSections = std::array<std::array<double, 5>, numBands * steepSectionsPerBand>;
+    static SteepBandSections designSteepSections(double sampleRate,
+                                                 float lowLowMid = defaultLowLowMidCrossover,
+                                                 float lowMidMid = defaultLowMidMidCrossover,
+                                                 float midHigh = defaultMidHighCrossover);
+
+    /** State key of a parameter, shared with the plugin's saved state. */
+    static const char* getParameterId(Parameter parameter) noexcept;
+    static float getParameterDefault(Parameter parameter) noexcept;
+
+    IsolatorCore();
+
+    // Band output tables point into the object itself
+    IsolatorCore(const IsolatorCore&) = delete;
+    IsolatorCore& operator=(const IsolatorCore&) = delete;
+
+    //==============================================================================
+    /**
+     * Incremental: a new rate redesigns the filters and reseeds the smoothers,
+     * a new rate or channel count clears the filter state, a larger block grows
+     * the buffers. Anything else keeps running state.
+     */
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels);
+    void reset() noexcept;
+
+    /** Clears the split's filter state only; the band dynamics carry on. */
+    void resetSplit() noexcept;
+
+    /** Processes up to the prepared number of channels in place. */
+    void process(float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Makes process() measure the split bands into the analyzer (null to stop).
+     * Analysis-only also skips the dynamics and the mix, leaving the channels as
+     * they came in, so a file can be measured much faster than real time.
+     */
+    void setAnalyzer(BandAnalyzer* analyzerToUse, bool analysisOnly) noexcept;
+
+    void setParameter(Parameter parameter, float value) noexcept;
+    float getParameter(Parameter parameter) const noexcept { return parameters[(size_t) parameter]; }
+
+    /** All gains (mid and side) at 0 dB, no band bypassed and no dynamics (or their release) running: the output equals the input. */
+    bool isNeutral() const noexcept;
+
+    /** "id=value" lines; unknown keys are ignored on restore, missing ones left as they are. */
+    std::string getState() const;
+    bool setState(const std::string& state);
+
+    //==============================================================================
+    // Stages of process(), for callers that insert their own processing
+
+    /** Control resolution (every sample or interpolated every 16) and Low/High slope order. */
+    void setCoarseControl(bool shouldBeCoarse) noexcept { coarseControl = shouldBeCoarse; }
+    void setReducedSlopes(bool shouldBeReduced) noexcept { reducedSlopes = shouldBeReduced; }
+
+    /** Advances the gain, bypass and slope smoothers by numSamples into the curves. */
+    void computeControlCurves(int numSamples);
+
+    /**
+     * Splits the inputs (may be band buffers of this core) into the band buffers.
+     * A channel pair carrying the same signal (within monoTolerance, and with
+     * filter states that have converged) is split once and the bands copied to
+     * the second channel, whose state follows the first so stereo content picks
+     * up without a step.
+     */
+    void splitBands(const float* const* inputs, int numChannels, int numSamples);
+
+    /**
+     * Mid and High only: splitBands() leaves the Low and Low-Mid band buffers to
+     * the caller (the multirate low branch) and their filters stand still. Their
+     * state is cleared at every switch, so they start again from silence.
+     */
+    void setUpperBandsOnly(bool shouldSplitUpperOnly) noexcept;
+
+    /** Largest L/R input difference still split once: -140 dBFS, below 24-bit resolution. */
+    static constexpr float monoTolerance = 1.0e-7f;
+
+    /** Dual-mono detection in splitBands (on by default). */
+    void setMonoDetection(bool shouldDetect) noexcept { monoDetection = shouldDetect; }
+
+    /** True if every channel pair of the last splitBands() was split once. */
+    bool wasLastSplitLinked() const noexcept { return lastSplitLinked; }
+
+    /**
+     * True while channels 0 and 1 run as mid/side: from the block the mode is
+     * switched on until the side gains have ramped back to the mid ones after it
+     * is switched off (the split state is converted at both ends, so the switch
+     * is seamless). Updated by computeControlCurves(); callers of the stages then
+     * encode the inputs in place before the split, and mixBands(),
+     * applyBandGains() and renderBand() decode.
+     */
+    bool isMidSideActive() const noexcept { return midSideActive; }
+
+    /** left, right = (left + right) / 2, (left - right) / 2, in place. */
+    static void encodeMidSide(float* left, float* right, int numSamples) noexcept;
+
+    /** Moves crossover points of the running split (no state reset). */
+    void setCrossovers(float lowLowMid, float lowMidMid, float midHigh);
+
+    /** bandOutputs[band][channel], valid up to the largest block seen. */
+    float* const* const* getBandOutputs() noexcept { return bandOutputs.data(); }
+    float* getBandData(int band, int channel) noexcept { return bandPointers[(size_t) band][(size_t) channel]; }
+
+    const float* getGainCurve(int band) const noexcept { return gainCurves[(size_t) band].data(); }
+    const float* getBypassCurve(int band) const noexcept { return bypassCurves[(size_t) band].data(); }
+    const float* getSideGainCurve(int band) const noexcept { return sideGainCurves[(size_t) band].data(); }
+    const float* getSideBypassCurve(int band) const noexcept { return sideBypassCurves[(size_t) band].data(); }
+
+    /**
+     * Folds the per-band dynamics into the gain curves: detection on the band
+     * signals (linked across channels), so it acts before the band gain. Free
+     * when every band is off and the last gain reduction has released.
+     */
+    void applyDynamics(int numChannels, int numSamples) noexcept;
+
+    /** Measures the band buffers (as split, before dynamics and gains) into an analyzer. */
+    void analyzeBands(BandAnalyzer& analyzer, int numChannels, int numSamples) const noexcept;
+
+    /** Current dynamics gain change of a band (dB, <= 0). */
+    float getGainChangeDecibels(int band) const noexcept;
+
+    /** band *= gain * bypass, in place (mid/side: then decoded back to left/right). */
+    void applyBandGains(int numChannels, int numSamples) noexcept;
+
+    /** outputs = sum of bands * gain * bypass (mid/side: decoded in the same pass). */
+    void mixBands(float* const* outputs, int numChannels, int numSamples) const noexcept;
+
+    /** One band into outputs, left/right: gained here unless applyBandGains() already ran. */
+    void renderBand(int band, float* const* outputs, int numChannels, int numSamples, bool alreadyGained) const noexcept;
+
+    /** outputs = plain sum of the bands (after applyBandGains). */
+    void sumBands(float* const* outputs, int numChannels, int numSamples) const noexcept;
+
+    int getNumChannels() const noexcept { return preparedNumChannels; }
+    double getSampleRate() const noexcept { return preparedSampleRate; }
+
+private:
+    // Linear ramp with the same stepping as juce::SmoothedValue<float>
+    struct LinearSmoother
+    {
+        void reset(double sampleRate, double rampSeconds) noexcept;
+        void setCurrentAndTargetValue(float value) noexcept;
+        void setTargetValue(float value) noexcept;
+        float getNextValue() noexcept;
+        float skip(int numSamples) noexcept;
+        bool isSmoothing() const noexcept { return countdown > 0; }
+        float getCurrentValue() const noexcept { return current; }
+
+        float current = 0.0f, target = 0.0f, step = 0.0f;
+        int countdown = 0, stepsToTarget = 0;
+    };
+
+    void growBuffers(int numSamples);
+    void applySections(const BandSections& sections);
+    void seedSmoothers() noexcept;
+    void updateDynamics() noexcept;
+    bool wantsMidSide() const noexcept;
+    bool sideMatchesMid() const noexcept;
+    bool isDynamicsRunning() const noexcept;
+
+    std::array<float, numParameters> parameters {};
+
+    double preparedSampleRate = 0.0;
+    int preparedNumChannels = 0;
+    int preparedBlockSize = 0;
+
+    // One splitter per channel pair, sharing one interleaved scratch
+    static constexpr int scratchFrames = 256;
+    std::vector<DspKernels::SplitState> splitters;
+    std::vector<float> splitScratch;
+    float dcBlockerR = 0.0f;
+    bool monoDetection = true;
+    bool lastSplitLinked = false;
+    std::array<float, 3> crossovers { { defaultLowLowMidCrossover, defaultLowMidMidCrossover, defaultMidHighCrossover } };
+
+    // Band buffers: bandStorage[(band * channels + channel) * capacity ...]
+    std::vector<float> bandStorage;
+    int bandCapacity = 0;
+    int bandLayoutChannels = -1;
+    std::array<std::array<float*, maxChannels>, numBands> bandPointers {};
+    std::array<float* const*, numBands> bandOutputs {};
+
+    std::array<LinearSmoother, numBands> gainSmoothers, bypassSmoothers;
+    LinearSmoother slopeSmoother;
+    std::array<std::vector<float>, numBands> gainCurves, bypassCurves;
+    std::vector<float> slopeCurve;
+    const float* slopeBlend = nullptr; // slopeCurve while the slope order crossfades, else null
+    bool reducedSlopes = false;
+    bool slopeSectionsSkipped = false; // settled at single section: the kernel skips the second
+    int slopeWarmupRemaining = 0;      // samples the second section runs unheard before it fades back in
+    bool coarseControl = false;
+    bool upperBandsOnly = false;
+
+    // Mid/side: side gain curves (used while midSideActive), seeded from the mid ones on the way in
+    std::array<LinearSmoother, numBands> sideGainSmoothers, sideBypassSmoothers;
+    std::array<std::vector<float>, numBands> sideGainCurves, sideBypassCurves;
+    bool midSideActive = false;
+
+    // Band dynamics: lane settings rebuilt when a dynamics parameter or the rate changes
+    DspKernels::DynamicsState dynamics;
+    std::vector<float> detectorStorage; // numBands * bandCapacity linked peak levels
+    bool dynamicsDirty = true;
+
+    // Measurement in process(), see setAnalyzer()
+    BandAnalyzer* analyzer = nullptr;
+    bool analyzeOnly = false;
+};
@@ -0,0 +1,286 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "MultirateLowBranch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+namespace
+{
+    double besselI0(double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum += term;
+        }
+        return sum;
+    }
+
+    std::array<float, HalfBandFIR::numPairs> designHalfBand() noexcept
+    {
+        constexpr double beta = 7.0;
+        constexpr double pi = 3.14159265358979323846;
+        const int length = HalfBandFIR::numTaps;
+
+        std::array<double, HalfBandFIR::numPairs> taps {};
+        double sum = 0.0;
+
+        for (int k = 0; k < HalfBandFIR::numPairs; ++k)
+        {
+            const int offset = 2 * k + 1;
+            const int n = HalfBandFIR::centre + offset;
+            const double ratio = 2.0 * n / (length - 1) - 1.0;
+            const double window = besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta);
+
+            // 0.5 * sinc(offset / 2) for odd offsets
+            const double sign = ((offset / 2) % 2 == 0) ? 1.0 : -1.0;
+            taps[(size_t) k] = sign / (pi * offset) * window;
+            sum += taps[(size_t) k];
+        }
+
+        // Unity gain at DC: 0.5 + 2 * sum(pairs) == 1
+        std::array<float, HalfBandFIR::numPairs> pairs {};
+        for (size_t k = 0; k < pairs.size(); ++k)
+            pairs[k] = (float) (taps[k] * 0.25 / sum);
+
+        return pairs;
+    }
+}
+
+const std::array<float, HalfBandFIR::numPairs>& HalfBandFIR::getPairs() noexcept
+{
+    static const auto pairs = designHalfBand();
+    return pairs;
+}
+
+//==============================================================================
+void HalfBandDecimator::reset() noexcept
+{
+    history.fill(0.0f);
+    writePos = 0;
+    oddPhase = false;
+}
+
+int HalfBandDecimator::process(const float* input, float* output, int numSamples) noexcept
+{
+    constexpr int length = HalfBandFIR::numTaps;
+    constexpr int centre = HalfBandFIR::centre;
+    const auto& pairs = HalfBandFIR::getPairs();
+    int produced = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Mirrored history: base[0..length) is contiguous, oldest first
+        history[(size_t) writePos] = input[i];
+        history[(size_t) (writePos + length)] = input[i];
+        const float* base = history.data() + writePos + 1;
+        if (++writePos >= length)
+            writePos = 0;
+
+        if (oddPhase)
+        {
+            float acc = 0.5f * base[centre];
+            for (int k = 0; k < HalfBandFIR::numPairs; ++k)
+            {
+                const int offset = 2 * k + 1;
+                acc += pairs[(size_t) k] * (base[centre - offset] + base[centre + offset]);
+            }
+            output[produced++] = acc;
+        }
+        oddPhase = ! oddPhase;
+    }
+
+    return produced;
+}
+
+//==============================================================================
+void HalfBandInterpolator::reset() noexcept
+{
+    history.fill(0.0f);
+    writePos = 0;
+}
+
+void HalfBandInterpolator::process(const float* input, float* output, int numSamples) noexcept
+{
+    const auto& pairs = HalfBandFIR::getPairs();
+    constexpr int newest = historyLength - 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[(size_t) writePos] = input[i];
+        history[(size_t) (writePos + historyLength)] = input[i];
+        const float* base = history.data() + writePos + 1; // base[newest] == u[m]
+        if (++writePos >= historyLength)
+            writePos = 0;
+
+        // Even phase: 2 * sum of the even-indexed taps; odd phase: centre tap only
+        float even = 0.0f;
+        for (int k = 0; k < HalfBandFIR::numPairs; ++k)
+        {
+            const int offset = 2 * k + 1;
+            even += pairs[(size_t) k] * (base[newest - (HalfBandFIR::centre - offset) / 2]
+                                       + base[newest - (HalfBandFIR::centre + offset) / 2]);
+        }
+
+        output[2 * i] = 2.0f * even;
+        output[2 * i + 1] = base[newest - HalfBandFIR::centre / 2];
+    }
+}
+
+//==============================================================================
+int MultirateLowBranch::getNumStagesForSampleRate(double sampleRate) noexcept
+{
+    int stages = 0;
+    while (stages < maxStages && sampleRate / (double) (1 << (stages + 1)) >= 22050.0)
+        ++stages;
+    return stages;
+}
+
+int MultirateLowBranch::getLatencyForStages(int stages) noexcept
+{
+    // Each decimator adds (centre - 1) and each interpolator centre samples at its
+    // own rate, plus (2^K - 1) samples of FIFO pre-roll: 30 * (2^K - 1) in total
+    const int factorMinusOne = (1 << stages) - 1;
+    return (2 * HalfBandFIR::centre - 1) * factorMinusOne + factorMinusOne;
+}
+
+void MultirateLowBranch::prepare(int stages, int maximumBlockSize)
+{
+    numStages = std::max(0, std::min(stages, maxStages));
+
+    const int factor = 1 << numStages;
+    const size_t scratchSize = (size_t) (maximumBlockSize + 2 * factor);
+    stageA.assign(scratchSize, 0.0f);
+    stageB.assign(scratchSize, 0.0f);
+    for (auto& band : reducedBands)
+        band.assign(scratchSize, 0.0f);
+
+    fifoSize = maximumBlockSize + 2 * factor;
+    for (auto& band : fifo)
+        band.assign((size_t) fifoSize, 0.0f);
+
+    delayRing.assign((size_t) (getLatencySamples() + std::max(1, maximumBlockSize)), 0.0f);
+
+    reset();
+}
+
+void MultirateLowBranch::reset() noexcept
+{
+    for (auto& decimator : decimators)
+        decimator.reset();
+    for (auto& bandInterpolators : interpolators)
+        for (auto& interpolator : bandInterpolators)
+            interpolator.reset();
+
+    // Pre-roll so a full block can always be read, whatever the decimation phase
+    for (auto& band : fifo)
+        std::fill(band.begin(), band.end(), 0.0f);
+    fifoRead = 0;
+    fifoCount = (1 << numStages) - 1;
+
+    std::fill(delayRing.begin(), delayRing.end(), 0.0f);
+    delayWrite = 0;
+}
+
+int MultirateLowBranch::decimate(const float* input, int numSamples) noexcept
+{
+    int count = numSamples;
+
+    if (numStages == 0)
+    {
+        std::copy(input, input + numSamples, reducedBands[0].begin());
+    }
+    else
+    {
+        const float* source = input;
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            float* destination = (stage == numStages - 1) ? reducedBands[0].data()
+                                                          : (stage % 2 == 0 ? stageA.data() : stageB.data());
+            count = decimators[(size_t) stage].process(source, destination, count);
+            source = destination;
+        }
+    }
+
+    std::copy(reducedBands[0].begin(), reducedBands[0].begin() + count, reducedBands[1].begin());
+    return count;
+}
+
+void MultirateLowBranch::interpolate(int numReducedSamples, float* lowOut, float* lowMidOut, int numSamples) noexcept
+{
+    float* const outputs[numBands] = { lowOut, lowMidOut };
+    const int writeStart = (fifoRead + fifoCount) % fifoSize;
+    int produced = numReducedSamples;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const float* source = reducedBands[(size_t) band].data();
+        produced = numReducedSamples;
+
+        for (int stage = numStages - 1; stage >= 0; --stage)
+        {
+            float* destination = (stage % 2 == 0) ? stageA.data() : stageB.data();
+            interpolators[(size_t) band][(size_t) stage].process(source, destination, produced);
+            produced *= 2;
+            source = destination;
+        }
+
+        auto& ring = fifo[(size_t) band];
+        int writePos = writeStart;
+        for (int i = 0; i < produced; ++i)
+        {
+            ring[(size_t) writePos] = source[i];
+            if (++writePos >= fifoSize)
+                writePos = 0;
+        }
+
+        int readPos = fifoRead;
+        float* out = outputs[band];
+        for (int i = 0; i < numSamples; ++i)
+        {
+            out[i] = ring[(size_t) readPos];
+            if (++readPos >= fifoSize)
+                readPos = 0;
+        }
+    }
+
+    fifoCount += produced - numSamples;
+    fifoRead = (fifoRead + numSamples) % fifoSize;
+}
+
+void MultirateLowBranch::delay(const float* input, float* output, int numSamples) noexcept
+{
+    const int size = (int) delayRing.size();
+    const int latency = getLatencySamples();
+    if (size <= latency)
+        return;
+
+    float* const ring = delayRing.data();
+
+    // Write first, then read latency samples back: a block longer than the
+    // latency reads part of itself. The ring holds latency + one chunk.
+    for (int start = 0; start < numSamples; start += size - latency)
+    {
+        const int n = std::min(size - latency, numSamples - start);
+
+        const int firstWrite = std::min(n, size - delayWrite);
+        std::memcpy(ring + delayWrite, input + start, sizeof(float) * (size_t) firstWrite);
+        std::memcpy(ring, input + start + firstWrite, sizeof(float) * (size_t) (n - firstWrite));
+
+        const int readPos = (delayWrite - latency + size) % size;
+        const int firstRead = std::min(n, size - readPos);
+        std::memcpy(output + start, ring + readPos, sizeof(float) * (size_t) firstRead);
+        std::memcpy(output + start + firstRead, ring, sizeof(float) * (size_t) (n - firstRead));
+
+        delayWrite = (delayWrite + n) % size;
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+//==============================================================================
+/**
+ * Linear-phase half-band FIR (31 taps, Kaiser windowed) in polyphase form.
+ * Only the non-zero taps are evaluated and only at the low rate.
+ */
+struct HalfBandFIR
+{
+    static constexpr int numTaps = 31;
+    static constexpr int centre = numTaps / 2;       // group delay (input-rate samples)
+    static constexpr int numPairs = (centre + 1) / 2; // odd offsets 1, 3, ..., 15
+
+    // Symmetric tap pairs: h[centre +- (2k + 1)]; h[centre] = 0.5
+    static const std::array<float, numPairs>& getPairs() noexcept;
+};
+
+/** Streaming decimate-by-2. */
+class HalfBandDecimator
+{
+public:
+    void reset() noexcept;
+
+    /** Feeds numSamples, writes floor((phase + numSamples) / 2) outputs; returns the count. */
+    int process(const float* input, float* output, int numSamples) noexcept;
+
+private:
+    std::array<float, HalfBandFIR::numTaps * 2> history {};
+    int writePos = 0;
+    bool oddPhase = false;
+};
+
+/** Streaming interpolate-by-2 (two outputs per input). */
+class HalfBandInterpolator
+{
+public:
+    void reset() noexcept;
+
+    /** Writes 2 * numSamples outputs. */
+    void process(const float* input, float* output, int numSamples) noexcept;
+
+private:
+    static constexpr int historyLength = HalfBandFIR::centre + 1;
+    std::array<float, historyLength * 2> history {};
+    int writePos = 0;
+};
+
+//==============================================================================
+/**
+ * Decimates one channel through a half-band cascade so the Low and Low-Mid
+ * bands can be filtered at a reduced rate, then interpolates both bands back.
+ *
+ * Arbitrary block sizes are handled by streaming every stage and holding the
+ * interpolated output in a small FIFO; the fixed end-to-end delay is
+ * getLatencySamples() (full-rate samples), which the full-rate bands must match.
+ */
+class MultirateLowBranch
+{
+public:
+    static constexpr int maxStages = 3;
+    static constexpr int numBands = 2; // Low, Low-Mid
+
+    /** Number of 2x stages that keeps the reduced rate at or above ~22 kHz. */
+    static int getNumStagesForSampleRate(double sampleRate) noexcept;
+
+    /** Latency of a cascade of numStages (decimation + interpolation + FIFO). */
+    static int getLatencyForStages(int numStages) noexcept;
+
+    void prepare(int numStages, int maximumBlockSize);
+    void reset() noexcept;
+
+    int getNumStages() const noexcept { return numStages; }
+    int getLatencySamples() const noexcept { return getLatencyForStages(numStages); }
+
+    /** Decimates a full-rate block; returns how many reduced-rate samples were produced. */
+    int decimate(const float* input, int numSamples) noexcept;
+
+    /** Reduced-rate buffer of a band, pre-filled with the decimated input by decimate(). */
+    float* getReducedBand(int band) noexcept { return reducedBands[(std::size_t) band].data(); }
+
+    /** Interpolates the reduced-rate bands and writes numSamples full-rate samples of each. */
+    void interpolate(int numReducedSamples, float* lowOut, float* lowMidOut, int numSamples) noexcept;
+
+    /** Delays a full-rate block by getLatencySamples() (block copies through a ring), for the full-rate bands. */
+    void delay(const float* input, float* output, int numSamples) noexcept;
+
+private:
+    int numStages = 0;
+    int fifoSize = 0;
+
+    std::array<HalfBandDecimator, maxStages> decimators;
+    std::array<std::array<HalfBandInterpolator, maxStages>, numBands> interpolators;
+
+    std::vector<float> stageA, stageB;                  // ping-pong scratch
+    std::array<std::vector<float>, numBands> reducedBands;
+
+    // Interpolated full-rate output waiting to be consumed (per band ring)
+    std::array<std::vector<float>, numBands> fifo;
+    int fifoRead = 0, fifoCount = 0;
+
+    // Full-rate input, latency + maximum block size long
+    std::vector<float> delayRing;
+    int delayWrite = 0;
+};
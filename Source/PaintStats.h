@@ -0,0 +1,56 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+ * Paint-time statistics of one component, message thread only.
+ * Cumulative totals plus a window that the debug overlay reads and restarts,
+ * so GUI cost per instance can be budgeted (paints/s and ms per second).
+ */
+struct PaintStats
+{
+    int totalPaints = 0;
+    double lastMs = 0.0;
+
+    int windowPaints = 0;
+    double windowMs = 0.0;
+    double windowMaxMs = 0.0;
+
+    void add(double ms) noexcept
+    {
+        ++totalPaints;
+        lastMs = ms;
+        ++windowPaints;
+        windowMs += ms;
+        windowMaxMs = juce::jmax(windowMaxMs, ms);
+    }
+
+    void restartWindow() noexcept
+    {
+        windowPaints = 0;
+        windowMs = 0.0;
+        windowMaxMs = 0.0;
+    }
+
+    // Times the enclosing paint() into the stats
+    struct ScopedMeasurement
+    {
+        explicit ScopedMeasurement(PaintStats& s) noexcept
+            : stats(s), startTicks(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedMeasurement()
+        {
+            stats.add(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0);
+        }
+
+        PaintStats& stats;
+        const juce::int64 startTicks;
+    };
+};
@@ -0,0 +1,186 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "PeakLimiter.h"
+#include "DspKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+void PeakLimiter::prepare(double newSampleRate, int maximumBlockSize, int numChannels, float maxLookaheadMs)
+{
+    sampleRate = newSampleRate;
+    maxBlockSize = std::max(1, maximumBlockSize);
+    maxLookahead = std::max(0, (int) std::ceil(maxLookaheadMs * 0.001 * sampleRate));
+    lookahead = std::min(lookahead, maxLookahead);
+
+    dequeValues.assign((size_t) maxLookahead + 2, 0.0f);
+    dequeIndices.assign((size_t) maxLookahead + 2, 0);
+    boxRing.assign((size_t) maxLookahead + 1, 1.0f);
+
+    delayLines.resize((size_t) std::max(0, numChannels));
+    for (auto& line : delayLines)
+        line.assign((size_t) maxLookahead + 1, 0.0f);
+
+    detector.assign((size_t) maxBlockSize, 0.0f);
+    gain.assign((size_t) maxBlockSize, 1.0f);
+    boxLeaving.assign((size_t) maxBlockSize, 1.0f);
+
+    setReleaseMs(releaseMs);
+    reset();
+}
+
+void PeakLimiter::reset() noexcept
+{
+    releaseState = 1.0f;
+
+    dequeHead = 0;
+    dequeSize = 0;
+    sampleCounter = 0;
+
+    std::fill(boxRing.begin(), boxRing.end(), 1.0f);
+    boxPos = 0;
+    boxSum = (double) (lookahead + 1);
+
+    for (auto& line : delayLines)
+        std::fill(line.begin(), line.end(), 0.0f);
+    delayWritePos = 0;
+}
+
+void PeakLimiter::setLookaheadSamples(int newLookahead) noexcept
+{
+    newLookahead = std::max(0, std::min(newLookahead, maxLookahead));
+    if (newLookahead == lookahead)
+        return;
+
+    lookahead = newLookahead;
+    reset();
+}
+
+void PeakLimiter::setCeilingDecibels(float ceilingDb) noexcept
+{
+    ceiling = std::pow(10.0f, std::min(ceilingDb, 0.0f) * 0.05f);
+}
+
+void PeakLimiter::setReleaseMs(float newReleaseMs) noexcept
+{
+    releaseMs = std::max(newReleaseMs, 1.0f);
+    releaseCoeff = 1.0f - (float) std::exp(-1.0 / (releaseMs * 0.001 * sampleRate));
+}
+
+//==============================================================================
+float PeakLimiter::pushWindowMax(float value) noexcept
+{
+    const int capacity = (int) dequeValues.size();
+
+    // Drop everything that can never be the maximum again
+    while (dequeSize > 0)
+    {
+        const int back = (dequeHead + dequeSize - 1) % capacity;
+        if (dequeValues[(size_t) back] > value)
+            break;
+        --dequeSize;
+    }
+
+    const int slot = (dequeHead + dequeSize) % capacity;
+    dequeValues[(size_t) slot] = value;
+    dequeIndices[(size_t) slot] = sampleCounter;
+    ++dequeSize;
+
+    // Expire the front once it falls out of the window [n - lookahead, n]
+    const int64_t oldest = sampleCounter - lookahead;
+    while (dequeIndices[(size_t) dequeHead] < oldest)
+    {
+        dequeHead = (dequeHead + 1) % capacity;
+        --dequeSize;
+    }
+
+    ++sampleCounter;
+    return dequeValues[(size_t) dequeHead];
+}
+
+void PeakLimiter::process(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    numChannels = std::min(numChannels, (int) delayLines.size());
+    if (numChannels <= 0 || maxBlockSize <= 0)
+        return;
+
+    const int windowLength = lookahead + 1;
+    const double invWindow = 1.0 / (double) windowLength;
+    const int delaySize = maxLookahead + 1;
+    const auto& kernels = DspKernels::get();
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int n = std::min(maxBlockSize, numSamples - start);
+        float* const peak = detector.data();
+        float* const g = gain.data();
+
+        // Linked detector: max |x| across channels
+        for (int ch = 0; ch < numChannels; ++ch)
+            kernels.absMax(peak, channels[ch] + start, n, ch > 0);
+
+        // Sliding max -> target gain -> instant attack / one-pole release. Stays serial:
+        // the attack is a min against the running state, so each sample needs the last
+        for (int i = 0; i < n; ++i)
+        {
+            const float windowPeak = pushWindowMax(peak[i]);
+            const float target = windowPeak > ceiling ? ceiling / windowPeak : 1.0f;
+
+            if (target < releaseState)
+                releaseState = target;
+            else
+                releaseState += releaseCoeff * (target - releaseState);
+
+            g[i] = releaseState;
+        }
+
+        // Box filter over the window: the ramp reaches the held minimum exactly
+        // when the delayed peak reaches the output, so the ceiling is never crossed.
+        // What leaves the window at each sample is the ring's oldest values, then
+        // this block's own; the ring then keeps the last windowLength gains.
+        float* const leaving = boxLeaving.data();
+        const int fromRing = std::min(n, windowLength);
+        const int ringFirst = std::min(fromRing, windowLength - boxPos);
+        std::copy_n(boxRing.data() + boxPos, ringFirst, leaving);
+        std::copy_n(boxRing.data(), fromRing - ringFirst, leaving + ringFirst);
+        std::copy_n(g, n - fromRing, leaving + fromRing);
+
+        const int keepFrom = n - fromRing;
+        const int keepAt = (boxPos + keepFrom) % windowLength;
+        const int keepFirst = std::min(fromRing, windowLength - keepAt);
+        std::copy_n(g + keepFrom, keepFirst, boxRing.data() + keepAt);
+        std::copy_n(g + keepFrom + keepFirst, fromRing - keepFirst, boxRing.data());
+        boxPos = (boxPos + n) % windowLength;
+
+        kernels.boxFilter(g, leaving, n, &boxSum, invWindow);
+
+        // Delay the audio by the look-ahead and apply the gain (vectorisable multiply)
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* const data = channels[ch] + start;
+            float* const line = delayLines[(size_t) ch].data();
+            int writePos = delayWritePos;
+
+            for (int i = 0; i < n; ++i)
+            {
+                line[writePos] = data[i];
+                int readPos = writePos - lookahead;
+                if (readPos < 0)
+                    readPos += delaySize;
+                data[i] = line[readPos];
+                if (++writePos >= delaySize)
+                    writePos = 0;
+            }
+
+            for (int i = 0; i < n; ++i)
+                data[i] *= g[i];
+        }
+
+        delayWritePos = (delayWritePos + n) % delaySize;
+    }
+}
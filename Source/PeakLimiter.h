@@ -0,0 +1,77 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * Look-ahead brickwall peak limiter (linked across channels).
+ *
+ * The detector is a monotonic-deque sliding maximum, so the cost per sample is
+ * O(1) amortised regardless of the look-ahead length. The held gain is
+ * released with a one-pole and then box-filtered over the look-ahead window,
+ * which guarantees the gain has fully reached its target by the time the
+ * peak leaves the delay line. Latency == getLookaheadSamples().
+ */
+class PeakLimiter
+{
+public:
+    PeakLimiter() = default;
+
+    /** Allocates everything; nothing is allocated in process(). */
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, float maxLookaheadMs);
+    void reset() noexcept;
+
+    /** Clamped to the maximum given to prepare(). Resets the limiter if it changes, so call it
+        while not processing (e.g. right after prepare()). */
+    void setLookaheadSamples(int newLookahead) noexcept;
+    int getLookaheadSamples() const noexcept { return lookahead; }
+    int getMaxLookaheadSamples() const noexcept { return maxLookahead; }
+
+    void setCeilingDecibels(float ceilingDb) noexcept;
+    void setReleaseMs(float releaseMs) noexcept;
+
+    /** Limits the channels in place; output is delayed by getLookaheadSamples(). */
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    // Sliding-window maximum over the last 'windowLength' detector samples
+    float pushWindowMax(float value) noexcept;
+
+    double sampleRate = 44100.0;
+    int maxBlockSize = 0;
+    int maxLookahead = 0;
+    int lookahead = 0;
+
+    float ceiling = 1.0f;
+    float releaseMs = 100.0f;
+    float releaseCoeff = 0.0f;
+    float releaseState = 1.0f;
+
+    // Monotonic deque (ring) of (value, sample index), values strictly decreasing front to back
+    std::vector<float> dequeValues;
+    std::vector<int64_t> dequeIndices;
+    int dequeHead = 0;
+    int dequeSize = 0;
+    int64_t sampleCounter = 0;
+
+    // Box filter over the look-ahead window (ring oldest first from boxPos)
+    std::vector<float> boxRing;
+    int boxPos = 0;
+    double boxSum = 0.0;
+
+    // Per-channel audio delay lines (length maxLookahead + 1)
+    std::vector<std::vector<float>> delayLines;
+    int delayWritePos = 0;
+
+    // Block scratch
+    std::vector<float> detector;
+    std::vector<float> gain;
+    std::vector<float> boxLeaving;
+};
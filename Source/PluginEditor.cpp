@@ -9,7 +9,7 @@
 
 //==============================================================================
 EQIsolator4AudioProcessorEditor::EQIsolator4AudioProcessorEditor (EQIsolator4AudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), responseCurve (p)
 {
     // Set up title label with creator watermark
     titleLabel.setText("EQIsolator4", juce::dontSendNotification);
@@ -24,23 +24,58 @@ EQIsolator4AudioProcessorEditor::EQIsolator4AudioProcessorEditor (EQIsolator4Aud
     watermarkLabel.setColour(juce::Label::textColourId, juce::Colours::grey.withAlpha(0.9f));
     addAndMakeVisible(watermarkLabel);
     
-    // Set up band labels with frequency ranges
-    lowLabel.setText("Low\n(20-200Hz)", juce::dontSendNotification);
+    // Set up band labels with frequency ranges (derived from the crossover constants)
+    auto formatFrequency = [](float hz)
+    {
+        return hz < 1000.0f ? juce::String(juce::roundToInt(hz)) + "Hz"
+                            : juce::String(hz / 1000.0f, std::fmod(hz, 1000.0f) == 0.0f ? 0 : 1) + "kHz";
+    };
+    auto bandText = [&formatFrequency](const juce::String& name, float lowHz, float highHz)
+    {
+        return name + "\n(" + formatFrequency(lowHz) + "-" + formatFrequency(highHz) + ")";
+    };
+    
+    lowLabel.setText(bandText("Low", 20.0f, EQIsolator4AudioProcessor::LOW_LOWMID_CROSSOVER_FREQ), juce::dontSendNotification);
     lowLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(lowLabel);
     
-    lowMidLabel.setText("Low-Mid\n(200-750Hz)", juce::dontSendNotification);
+    lowMidLabel.setText(bandText("Low-Mid", EQIsolator4AudioProcessor::LOW_LOWMID_CROSSOVER_FREQ,
+                                 EQIsolator4AudioProcessor::LOWMID_MID_CROSSOVER_FREQ), juce::dontSendNotification);
     lowMidLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(lowMidLabel);
     
-    midLabel.setText("Mid\n(750Hz-3kHz)", juce::dontSendNotification);
+    midLabel.setText(bandText("Mid", EQIsolator4AudioProcessor::LOWMID_MID_CROSSOVER_FREQ,
+                              EQIsolator4AudioProcessor::MID_HIGH_CROSSOVER_FREQ), juce::dontSendNotification);
     midLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(midLabel);
     
-    highLabel.setText("High\n(3-20kHz)", juce::dontSendNotification);
+    highLabel.setText(bandText("High", EQIsolator4AudioProcessor::MID_HIGH_CROSSOVER_FREQ, 20000.0f), juce::dontSendNotification);
     highLabel.setJustificationType(juce::Justification::centred);
     addAndMakeVisible(highLabel);
     
+    addAndMakeVisible(responseCurve);
+    
+    // Governor status, polled from the processor's telemetry
+    governorLabel.setFont(juce::Font("Roboto", 12.0f, juce::Font::plain));
+    governorLabel.setJustificationType(juce::Justification::centredLeft);
+    governorLabel.setColour(juce::Label::textColourId, juce::Colours::grey.withAlpha(0.9f));
+    addAndMakeVisible(governorLabel);
+    
+    // Paint-cost overlay; opaque so its updates don't repaint what lies beneath
+   #if JUCE_DEBUG
+    const bool showPaintStats = true;
+   #else
+    const bool showPaintStats = juce::SystemStats::getEnvironmentVariable("EQISOLATOR4_PAINT_STATS", {}).getIntValue() != 0;
+   #endif
+    paintStatsLabel.setFont(juce::Font("Roboto", 10.0f, juce::Font::plain));
+    paintStatsLabel.setJustificationType(juce::Justification::topLeft);
+    paintStatsLabel.setColour(juce::Label::backgroundColourId, juce::Colours::black);
+    paintStatsLabel.setColour(juce::Label::textColourId, juce::Colours::lightgreen);
+    paintStatsLabel.setOpaque(true);
+    paintStatsLabel.setInterceptsMouseClicks(false, false);
+    addChildComponent(paintStatsLabel);
+    paintStatsLabel.setVisible(showPaintStats);
+    
     // Set up sliders using parameter ranges
     lowGainSlider.setSliderStyle(juce::Slider::LinearVertical);
     lowGainSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 70, 20);
@@ -82,17 +117,114 @@ EQIsolator4AudioProcessorEditor::EQIsolator4AudioProcessorEditor (EQIsolator4Aud
     midBypassAttachment = std::make_unique<juce::ButtonParameterAttachment>(*audioProcessor.midBypassParam, midBypassButton);
     highBypassAttachment = std::make_unique<juce::ButtonParameterAttachment>(*audioProcessor.highBypassParam, highBypassButton);
     
-    // Set editor size for 4 bands
-    setSize (580, 300);
+    // Set editor size for 4 bands plus the response display
+    setOpaque(true);
+    setSize (580, 450);
+    
+    updateGovernorLabel();
 }
 
 EQIsolator4AudioProcessorEditor::~EQIsolator4AudioProcessorEditor()
 {
+    vBlankAttachment.reset();
+}
+
+void EQIsolator4AudioProcessorEditor::visibilityChanged()
+{
+    updateFrameClock();
+}
+
+void EQIsolator4AudioProcessorEditor::parentHierarchyChanged()
+{
+    updateFrameClock();
+}
+
+void EQIsolator4AudioProcessorEditor::updateFrameClock()
+{
+    if (isShowing() && vBlankAttachment == nullptr)
+        vBlankAttachment = std::make_unique<juce::VBlankAttachment>(this, [this] { onVBlank(); });
+    else if (! isShowing())
+        vBlankAttachment.reset();
+}
+
+void EQIsolator4AudioProcessorEditor::onVBlank()
+{
+    // Minimised windows keep the attachment but never repaint
+    if (! isShowing())
+        return;
+    
+    // Cheap poll of atomics every frame; the curve repaints itself only when a new evaluation lands
+    responseCurve.refresh();
+    
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (nowMs - lastGovernorUpdateMs >= 250.0)
+    {
+        lastGovernorUpdateMs = nowMs;
+        updateGovernorLabel();
+    }
+    
+    if (paintStatsLabel.isVisible() && nowMs - lastPaintStatsUpdateMs >= 1000.0)
+    {
+        updatePaintStatsOverlay(lastPaintStatsUpdateMs > 0.0 ? nowMs - lastPaintStatsUpdateMs : 1000.0);
+        lastPaintStatsUpdateMs = nowMs;
+    }
+}
+
+void EQIsolator4AudioProcessorEditor::updatePaintStatsOverlay(double elapsedMs)
+{
+    // Per component: paints per second, average / worst paint, share of the message thread
+    auto describe = [elapsedMs](const char* name, PaintStats& stats)
+    {
+        const double seconds = elapsedMs * 0.001;
+        const auto text = juce::String(name) + " " + juce::String(stats.windowPaints / seconds, 1) + "/s  avg "
+                        + juce::String(stats.windowPaints > 0 ? stats.windowMs / stats.windowPaints : 0.0, 3) + " ms  max "
+                        + juce::String(stats.windowMaxMs, 3) + " ms  "
+                        + juce::String(stats.windowMs / elapsedMs * 100.0, 2) + "%";
+        stats.restartWindow();
+        return text;
+    };
+    
+    paintStatsLabel.setText(describe("editor", paintStats) + "\n" + describe("curve ", responseCurve.getPaintStats()),
+                            juce::dontSendNotification);
+}
+
+void EQIsolator4AudioProcessorEditor::updateGovernorLabel()
+{
+    const auto& telemetry = audioProcessor.getTelemetry();
+    const int tier = telemetry.governorTier.load(std::memory_order_relaxed);
+    const float load = telemetry.governorLoad.load(std::memory_order_relaxed);
+    
+    static const char* const tierNames[CpuGovernor::numTiers] = { "Full quality", "Reduced: coarse gain ramps", "Reduced: 12 dB/oct Low/High" };
+    const auto text = "CPU " + juce::String(juce::roundToInt(load * 100.0f)) + "%  -  "
+                    + tierNames[juce::jlimit(0, (int) CpuGovernor::numTiers - 1, tier)];
+    
+    governorLabel.setText(text, juce::dontSendNotification);
+    governorLabel.setColour(juce::Label::textColourId, tier > CpuGovernor::tierFull ? juce::Colours::orange
+                                                                                    : juce::Colours::grey.withAlpha(0.9f));
 }
 
 //==============================================================================
 void EQIsolator4AudioProcessorEditor::paint (juce::Graphics& g)
 {
+    const PaintStats::ScopedMeasurement measurement(paintStats);
+    
+    // Static chrome is re-rendered only on resize or a display scale change
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! backgroundImage.isValid() || scale != backgroundScale)
+        renderBackground(scale);
+    
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+}
+
+void EQIsolator4AudioProcessorEditor::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt((float) getWidth() * scale)),
+                                  juce::jmax(1, juce::roundToInt((float) getHeight() * scale)), false);
+    
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    
     // Fill the background
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
     
@@ -111,6 +243,7 @@ void EQIsolator4AudioProcessorEditor::resized()
     
     // 💎 PROTECTED WATERMARK POSITIONING 💎
     watermarkLabel.setBounds(getWidth() - 120, getHeight() - 18, 115, 16);
+    governorLabel.setBounds(10, getHeight() - 18, 300, 16);
     
     // Low band (20-200Hz)
     lowLabel.setBounds(10, 50, 135, 35);
@@ -131,5 +264,13 @@ void EQIsolator4AudioProcessorEditor::resized()
     highLabel.setBounds(430, 50, 135, 35);
     highGainSlider.setBounds(445, 90, 105, 130);
     highBypassButton.setBounds(450, 225, 95, 25);
+    
+    // Combined response below the bands
+    responseCurve.setBounds(10, 288, 555, 140);
+    
+    // Debug overlay in the free top-left corner
+    paintStatsLabel.setBounds(10, 4, 230, 28);
+    
+    backgroundImage = {};
 }
 
@@ -9,11 +9,16 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "PluginProcessor.h"
+#include "ResponseCurveComponent.h"
+#include "PaintStats.h"
 
 //==============================================================================
 /**
  * EQIsolator4 - Basic editor component
  * A minimal editor with sliders and toggles for the 4-band EQ
+ *
+ * Static chrome is rendered once into an image; dynamic parts repaint only their
+ * own bounds from a vblank callback that exists only while the editor is showing.
  */
 class EQIsolator4AudioProcessorEditor : public juce::AudioProcessorEditor
 {
@@ -24,8 +29,17 @@ public:
     //==============================================================================
     void paint(juce::Graphics&) override;
     void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
 
 private:
+    // Attaches the vblank callback while showing and drops it otherwise, so a hidden editor costs nothing
+    void updateFrameClock();
+    void onVBlank();
+    void updateGovernorLabel();
+    void updatePaintStatsOverlay(double elapsedMs);
+    void renderBackground(float scale);
+    
     // Reference to the processor to update parameters
     EQIsolator4AudioProcessor& audioProcessor;
     
@@ -37,6 +51,21 @@ private:
     juce::Label lowLabel, lowMidLabel, midLabel, highLabel;
     juce::Label titleLabel;
     juce::Label watermarkLabel; // 💎 Protected creator watermark 💎
+    juce::Label governorLabel;  // CPU load and current governor tier
+    juce::Label paintStatsLabel; // debug overlay: GUI paint cost (debug builds or EQISOLATOR4_PAINT_STATS=1)
+    
+    // Live combined frequency response
+    ResponseCurveComponent responseCurve;
+    
+    // Frame clock and throttles for the slower readouts (ms, Time::getMillisecondCounterHiRes)
+    std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+    double lastGovernorUpdateMs = 0.0;
+    double lastPaintStatsUpdateMs = 0.0;
+    
+    // Background fill and band frames at the display's pixel scale
+    juce::Image backgroundImage;
+    float backgroundScale = 0.0f;
+    PaintStats paintStats;
     
     // Parameter attachments for automatic synchronization
     std::unique_ptr<juce::SliderParameterAttachment> lowGainAttachment;
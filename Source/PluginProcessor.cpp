@@ -7,12 +7,37 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // Float parameter the host shows and stores but cannot automate; reports every change
+    class NonAutomatableFloatParameter : public juce::AudioParameterFloat
+    {
+    public:
+        using juce::AudioParameterFloat::AudioParameterFloat;
+        
+        std::function<void()> onChange;
+        
+        bool isAutomatable() const override { return false; }
+        
+    private:
+        void valueChanged(float) override
+        {
+            if (onChange != nullptr)
+                onChange();
+        }
+    };
+}
 
 //==============================================================================
 EQIsolator4AudioProcessor::EQIsolator4AudioProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
-                     .withOutput("Output", juce::AudioChannelSet::stereo(), true))
+                     .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+                     // Optional per-band outputs for single-pass stem splitting (disabled by default)
+                     .withOutput("Low", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("Low-Mid", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("Mid", juce::AudioChannelSet::stereo(), false)
+                     .withOutput("High", juce::AudioChannelSet::stereo(), false))
 {
     static const juce::NormalisableRange<float> gainRange(-100.0f, 24.0f, 0.1f);
     static const auto gainStringConverter = [](float value, int) -> juce::String 
@@ -40,13 +65,105 @@ EQIsolator4AudioProcessor::EQIsolator4AudioProcessor()
     addParameter(lowMidBypassParam = new juce::AudioParameterBool(LOWMID_BYPASS_ID, "Low-Mid Band Bypass", false));
     addParameter(midBypassParam = new juce::AudioParameterBool(MID_BYPASS_ID, "Mid Band Bypass", false));
     addParameter(highBypassParam = new juce::AudioParameterBool(HIGH_BYPASS_ID, "High Band Bypass", false));
+
+    // Low and Low-Mid bands processed at a reduced rate (adds latency)
+    addParameter(multirateParam = new juce::AudioParameterBool(MULTIRATE_ID, "Multirate Low Bands", false));
+    
+    // Swap to the high-quality engine automatically when the host renders offline
+    addParameter(offlineHqParam = new juce::AudioParameterBool(OFFLINE_HQ_ID, "Offline HQ Render", true));
+    
+    // CPU governor: trades isolation quality for headroom near the deadline (opt-in: it changes the sound)
+    addParameter(governorParam = new juce::AudioParameterBool(GOVERNOR_ID, "CPU Governor", false));
+    
+    addParameter(cpuBudgetParam = new juce::AudioParameterFloat(
+        CPU_BUDGET_ID, "CPU Budget", juce::NormalisableRange<float>(20.0f, 95.0f, 1.0f), 70.0f,
+        juce::String(), juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(juce::roundToInt(value)) + " %"; }));
+    
+    // Look-ahead brickwall limiter (per band and/or on the summed output)
+    addParameter(limiterModeParam = new juce::AudioParameterChoice(
+        LIMITER_MODE_ID, "Limiter Mode", juce::StringArray { "Off", "Output", "Per-Band", "Per-Band + Output" }, limiterOff));
+
+    addParameter(limiterCeilingParam = new juce::AudioParameterFloat(
+        LIMITER_CEILING_ID, "Limiter Ceiling", juce::NormalisableRange<float>(-24.0f, 0.0f, 0.1f), -0.3f,
+        juce::String(), juce::AudioProcessorParameter::genericParameter, gainStringConverter));
+
+    // Look-ahead sets the latency, so it is not automatable and only applied in prepareToPlay();
+    // a change reports the new latency from the message thread so the host re-prepares
+    auto* lookahead = new NonAutomatableFloatParameter(
+        LIMITER_LOOKAHEAD_ID, "Limiter Look-ahead", juce::NormalisableRange<float>(0.0f, MAX_LIMITER_LOOKAHEAD_MS, 0.1f), 1.5f,
+        juce::String(), juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + " ms"; });
+    lookahead->onChange = [this] { triggerAsyncUpdate(); };
+    addParameter(limiterLookaheadParam = lookahead);
+
+    addParameter(limiterReleaseParam = new juce::AudioParameterFloat(
+        LIMITER_RELEASE_ID, "Limiter Release", juce::NormalisableRange<float>(10.0f, 1000.0f, 1.0f, 0.4f), 120.0f,
+        juce::String(), juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(juce::roundToInt(value)) + " ms"; }));
+    
+    static const char* const bandNames[] = { "Low", "Low-Mid", "Mid", "High" };
+    
+    // Per-band compressor / expander / gate on the split bands, before the band gain
+    {
+        const auto msStringConverter = [](float value, int) { return juce::String(value, value < 10.0f ? 1 : 0) + " ms"; };
+        const auto ratioStringConverter = [](float value, int) { return juce::String(value, 1) + ":1"; };
+        
+        const auto makeFloat = [](IsolatorCore::Parameter parameter, const juce::String& name, float minimum, float maximum,
+                                  float interval, float skew, std::function<juce::String(float, int)> toString)
+        {
+            return new juce::AudioParameterFloat(IsolatorCore::getParameterId(parameter), name,
+                                                 juce::NormalisableRange<float>(minimum, maximum, interval, skew),
+                                                 IsolatorCore::getParameterDefault(parameter), juce::String(),
+                                                 juce::AudioProcessorParameter::genericParameter, std::move(toString));
+        };
+        
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            const juce::String bandName(bandNames[band]);
+            const auto parameter = [band](IsolatorCore::Parameter first) { return (IsolatorCore::Parameter) (first + band); };
+            
+            addParameter(dynamicsModeParams[(size_t) band] = new juce::AudioParameterChoice(
+                IsolatorCore::getParameterId(parameter(IsolatorCore::lowDynamicsMode)), bandName + " Dynamics",
+                juce::StringArray { "Off", "Compressor", "Expander", "Gate" }, IsolatorCore::dynamicsOff));
+            addParameter(dynamicsThresholdParams[(size_t) band] = makeFloat(
+                parameter(IsolatorCore::lowThreshold), bandName + " Threshold", -60.0f, 0.0f, 0.1f, 1.0f, gainStringConverter));
+            addParameter(dynamicsRatioParams[(size_t) band] = makeFloat(
+                parameter(IsolatorCore::lowRatio), bandName + " Ratio", 1.0f, 20.0f, 0.1f, 0.4f, ratioStringConverter));
+            addParameter(dynamicsAttackParams[(size_t) band] = makeFloat(
+                parameter(IsolatorCore::lowAttack), bandName + " Attack", 0.1f, 200.0f, 0.1f, 0.3f, msStringConverter));
+            addParameter(dynamicsReleaseParams[(size_t) band] = makeFloat(
+                parameter(IsolatorCore::lowRelease), bandName + " Release", 5.0f, 2000.0f, 1.0f, 0.3f, msStringConverter));
+        }
+        
+        addParameter(dynamicsRangeParam = makeFloat(IsolatorCore::dynamicsRange, "Dynamics Range", 0.0f, 80.0f, 0.1f, 1.0f,
+                                                    gainStringConverter));
+    }
+    
+    // Global bypass, handed to the host by getBypassParameter() (added last so existing indices stay put)
+    addParameter(bypassParam = new juce::AudioParameterBool(BYPASS_ID, "Bypass", false));
     
+    // Mid/side: one split of mid and side with their own band gains (after the bypass, same reason)
+    addParameter(stereoModeParam = new juce::AudioParameterChoice(
+        IsolatorCore::getParameterId(IsolatorCore::stereoMode), "Stereo Mode",
+        juce::StringArray { "Left/Right", "Mid/Side" }, IsolatorCore::stereoLeftRight));
     
-    preallocatedBandBuffers.reserve(NUM_BANDS * MAX_CHANNELS);
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const juce::String bandName(bandNames[band]);
+        const auto id = [band](IsolatorCore::Parameter first) { return IsolatorCore::getParameterId((IsolatorCore::Parameter) (first + band)); };
+        
+        addParameter(sideGainParams[(size_t) band] = new juce::AudioParameterFloat(
+            id(IsolatorCore::lowSideGain), bandName + " Side Gain", gainRange, 0.0f,
+            juce::String(), juce::AudioProcessorParameter::genericParameter, gainStringConverter));
+        addParameter(sideBypassParams[(size_t) band] = new juce::AudioParameterBool(
+            id(IsolatorCore::lowSideBypass), bandName + " Side Bypass", false));
+    }
 }
 
 EQIsolator4AudioProcessor::~EQIsolator4AudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -117,176 +234,385 @@ void EQIsolator4AudioProcessor::changeProgramName(int index, const juce::String&
 //==============================================================================
 void EQIsolator4AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    // Hosts re-prepare often (transport, buffer size, device toggles), so only
+    // rebuild what the new spec actually invalidates and keep everything else warm.
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    
+    // Only the main bus is filtered; band buses are written from the same split
+    const int numCh = getMainBusNumOutputChannels();
+    const bool sampleRateChanged = (sampleRate != preparedSampleRate);
+    const bool channelsChanged = (numCh != preparedNumChannels);
+    const bool blockSizeGrew = (samplesPerBlock > preparedBlockSize);
+    
     // Processing specs
     processSpec.sampleRate = sampleRate;
-    processSpec.maximumBlockSize = samplesPerBlock;
-    processSpec.numChannels = getTotalNumOutputChannels();
-    
-    // Parameter smoothing (ramp times)
-    const float rampTimeMsLow    = 160.0f;  // Low band (more smoothing to avoid zipper noise)
-    const float rampTimeMsLowMid = 15.0f;
-    const float rampTimeMsMid    = 12.0f;
-    const float rampTimeMsHigh   = 10.0f;
-    
-    smoothedLowGain.reset(sampleRate, rampTimeMsLow / 1000.0f);
-    smoothedLowMidGain.reset(sampleRate, rampTimeMsLowMid / 1000.0f);
-    smoothedMidGain.reset(sampleRate, rampTimeMsMid / 1000.0f);
-    smoothedHighGain.reset(sampleRate, rampTimeMsHigh / 1000.0f);
-    
-    // Initial values without jumps (dB domain -> seed with current params)
-    smoothedLowGain.setCurrentAndTargetValue(lowGainParam->get());
-    smoothedLowMidGain.setCurrentAndTargetValue(lowMidGainParam->get());
-    smoothedMidGain.setCurrentAndTargetValue(midGainParam->get());
-    smoothedHighGain.setCurrentAndTargetValue(highGainParam->get());
-    lastLowGainTargetDb = lowGainParam->get();
-    
-    // Filter frequency smoothing (static crossovers)
-    smoothedLowCutoff.reset(sampleRate, rampTimeMsLow / 1000.0f);
-    smoothedLowMidCutoff.reset(sampleRate, rampTimeMsLowMid / 1000.0f);
-    smoothedMidCutoff.reset(sampleRate, rampTimeMsMid / 1000.0f);
-    
-    smoothedLowCutoff.setCurrentAndTargetValue(LOW_LOWMID_CROSSOVER_FREQ);
-    smoothedLowMidCutoff.setCurrentAndTargetValue(LOWMID_MID_CROSSOVER_FREQ);
-    smoothedMidCutoff.setCurrentAndTargetValue(MID_HIGH_CROSSOVER_FREQ);
-    
-    // Bypass smoothing (per-band)
-    const float bypassRampTimeMsLow    = 80.0f; // longer to avoid low-band pops
-    const float bypassRampTimeMsLowMid = 50.0f;
-    const float bypassRampTimeMsMid    = 40.0f;
-    const float bypassRampTimeMsHigh   = 25.0f;
-    
-    smoothedLowBypass.reset(sampleRate, bypassRampTimeMsLow / 1000.0f);
-    smoothedLowMidBypass.reset(sampleRate, bypassRampTimeMsLowMid / 1000.0f);
-    smoothedMidBypass.reset(sampleRate, bypassRampTimeMsMid / 1000.0f);
-    smoothedHighBypass.reset(sampleRate, bypassRampTimeMsHigh / 1000.0f);
-    
-    // Set initial bypass values (1.0 = no bypass, 0.0 = bypass activo)
-    smoothedLowBypass.setCurrentAndTargetValue(lowBypassParam->get() ? 0.0f : 1.0f);
-    smoothedLowMidBypass.setCurrentAndTargetValue(lowMidBypassParam->get() ? 0.0f : 1.0f);
-    smoothedMidBypass.setCurrentAndTargetValue(midBypassParam->get() ? 0.0f : 1.0f);
-    smoothedHighBypass.setCurrentAndTargetValue(highBypassParam->get() ? 0.0f : 1.0f);
-    
-    // Prepare filters for processing
-    prepareFilters(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
-    updateFilters();
-
-    // Allocate temp buffers per channel
-    const int numCh = getTotalNumOutputChannels();
-    lowTempBuffers.resize(numCh);
-    lowMidTempBuffers.resize(numCh);
-    midTempBuffers.resize(numCh);
-    highTempBuffers.resize(numCh);
-    for (int c = 0; c < numCh; ++c)
-    {
-        lowTempBuffers[c].setSize(1, samplesPerBlock);
-        lowMidTempBuffers[c].setSize(1, samplesPerBlock);
-        midTempBuffers[c].setSize(1, samplesPerBlock);
-        highTempBuffers[c].setSize(1, samplesPerBlock);
-    }
-
-    // Preallocate control curves to maximum block size
-    lowGainCurve.assign(samplesPerBlock, 1.0f);
-    lowMidGainCurve.assign(samplesPerBlock, 1.0f);
-    midGainCurve.assign(samplesPerBlock, 1.0f);
-    highGainCurve.assign(samplesPerBlock, 1.0f);
-    lowBypassCurve.assign(samplesPerBlock, 1.0f);
-    lowMidBypassCurve.assign(samplesPerBlock, 1.0f);
-    midBypassCurve.assign(samplesPerBlock, 1.0f);
-    highBypassCurve.assign(samplesPerBlock, 1.0f);
-
-    // Initialize DC blocker for low band (simple 1st-order high-pass at ~5 Hz)
-    // r = exp(-2*pi*fc/fs)
-    const double fc = 5.0;
-    dcBlockerR = (float) std::exp(-2.0 * juce::MathConstants<double>::pi * fc / sampleRate);
-    dcPrevXLow.assign(numCh, 0.0f);
-    dcPrevYLow.assign(numCh, 0.0f);
-}
-
-void EQIsolator4AudioProcessor::prepareFilters(double sampleRate, int samplesPerBlock, int numChannels)
-{
-    // Initialize filters for each channel and 4 bands
-    lowPassFilters.clear();
-    lowMidFilters.clear();
-    midFilters.clear();
-    highPassFilters.clear();
-    
-    for (int i = 0; i < numChannels; ++i)
-    {
-        // Create filters for each channel and each of the 4 bands
-        lowPassFilters.push_back(ProcessorChain());
-        lowMidFilters.push_back(ProcessorChain());
-        midFilters.push_back(ProcessorChain());
-        highPassFilters.push_back(ProcessorChain());
+    processSpec.maximumBlockSize = (juce::uint32) samplesPerBlock;
+    processSpec.numChannels = (juce::uint32) numCh;
+    
+    if (sampleRateChanged)
+    {
+        governor.prepare(sampleRate);
+        governorTier = CpuGovernor::tierFull;
+    }
+    
+    // Split/gain engine: incremental in the same way (a new rate or layout redesigns
+    // and clears the splitters, a larger block grows the band buffers and curves);
+    // the smoothers are seeded from the current parameters
+    pushCoreParameters();
+    core.prepare(sampleRate, samplesPerBlock, numCh);
+    
+    if (sampleRateChanged || channelsChanged)
+        bandAnalyzer.prepare(sampleRate, numCh);
+    if (blockSizeGrew)
+        analysisInputBuffer.setSize(2, samplesPerBlock);
+    
+    if (channelsChanged)
+        telemetry.filterRebuildCount.fetch_add(1, std::memory_order_relaxed);
+    if (channelsChanged || sampleRateChanged)
+        telemetry.coefficientUpdateCount.fetch_add(1, std::memory_order_relaxed);
+    if (channelsChanged || blockSizeGrew)
+        telemetry.bufferReallocationCount.fetch_add(1, std::memory_order_relaxed);
+    
+    // Limiters and band bus delays: allocate for the maximum look-ahead at this rate
+    const bool limitersNeedPrepare = sampleRateChanged || channelsChanged || blockSizeGrew;
+    if (limitersNeedPrepare)
+    {
+        const int blockSize = juce::jmax(samplesPerBlock, preparedBlockSize);
+        for (auto& limiter : bandLimiters)
+            limiter.prepare(sampleRate, blockSize, numCh, MAX_LIMITER_LOOKAHEAD_MS);
+        outputLimiter.prepare(sampleRate, blockSize, numCh, MAX_LIMITER_LOOKAHEAD_MS);
+        
+        for (auto& delay : bandBusDelays)
+        {
+            delay.setMaximumDelayInSamples(outputLimiter.getMaxLookaheadSamples() + 1);
+            delay.prepare(processSpec);
+        }
+        
+        limiterLookaheadSamples = -1;
+        limiterModeActive = -1;
+        lastLimiterCeilingDb = 1.0f;
+        lastLimiterReleaseMs = -1.0f;
+    }
+    
+    // Band buses are delayed to stay aligned with the output limiter's look-ahead
+    numBandBusesEnabled = 0;
+    for (int band = 0; band < NUM_BANDS; ++band)
+        if (auto* bus = getBus(false, band + 1))
+            numBandBusesEnabled += bus->isEnabled() ? 1 : 0;
+    
+    // Flight recorder rings (only when enabled); a new spec starts a new recording
+    if (flightRecorder.isEnabled() && (sampleRateChanged || channelsChanged || blockSizeGrew))
+    {
+        std::vector<std::string> parameterIds;
+        for (auto* parameter : getParameters())
+        {
+            auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+            parameterIds.push_back(withId != nullptr ? withId->paramID.toStdString() : std::string());
+        }
         
-        // Prepare each filter chain
-        lowPassFilters[i].prepare(processSpec);
-        lowMidFilters[i].prepare(processSpec);
-        midFilters[i].prepare(processSpec);
-        highPassFilters[i].prepare(processSpec);
+        flightRecorder.prepare(sampleRate, juce::jmax(samplesPerBlock, preparedBlockSize), numCh, parameterIds);
     }
+    
+    // Multirate low branch: stage count follows the sample rate
+    if (sampleRateChanged || channelsChanged || blockSizeGrew)
+        prepareMultirate(sampleRate, juce::jmax(samplesPerBlock, preparedBlockSize), numCh);
+    
+    preparedSampleRate = sampleRate;
+    preparedNumChannels = numCh;
+    preparedBlockSize = juce::jmax(samplesPerBlock, preparedBlockSize);
+    
+    // Offline engine: built here when the host prepares for an offline render, so a bounce
+    // doesn't build it (oversamplers, worker pool) on the audio thread; live instances never
+    // pay for it. Hosts that switch to offline without preparing again hit the fallback in
+    // updateHighQualitySettings().
+    const bool highQualityNeedsPrepare = isNonRealtime() && offlineHqParam->get() && numCh > 0
+                                      && ! highQualityEngine.isPreparedFor(sampleRate, numCh);
+    if (highQualityNeedsPrepare)
+    {
+        highQualityEngine.prepare(sampleRate, preparedBlockSize, numCh);
+        highQualityActive = false;
+    }
+    
+    // Bypass history (sized from the limiters, multirate branch and offline engine prepared
+    // above); an instance that is bypassed starts out fully bypassed rather than fading
+    if (sampleRateChanged || channelsChanged || blockSizeGrew || highQualityNeedsPrepare)
+        prepareHostBypass();
+    if (bypassParam->get())
+        hostBypass.setBypassed();
+    
+    updateHighQualitySettings();
+    updateMultirateSettings();
+    applyLimiterLookahead();
+    updateLimiterSettings();
+    updateLatency();
+    
+    const bool fullRebuild = sampleRateChanged || channelsChanged;
+    const double elapsedMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+    telemetry.lastPrepareMs.store(elapsedMs, std::memory_order_relaxed);
+    telemetry.lastPrepareWasFullRebuild.store(fullRebuild, std::memory_order_relaxed);
+    telemetry.prepareCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EQIsolator4AudioProcessor::updateLatency()
+{
+    const int splitLatency = highQualityActive ? highQualityEngine.getLatencySamples()
+                           : (multirateActive ? MultirateLowBranch::getLatencyForStages(multirateStages) : 0);
+    const int latency = limiterStages * limiterLookaheadSamples + splitLatency;
+    
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void EQIsolator4AudioProcessor::prepareMultirate(double sampleRate, int samplesPerBlock, int numChannels)
+{
+    multirateStages = MultirateLowBranch::getNumStagesForSampleRate(sampleRate);
+    const double reducedRate = sampleRate / (double) (1 << multirateStages);
+    
+    multirateBranches.resize((size_t) numChannels);
+    for (auto& branch : multirateBranches)
+        branch.prepare(multirateStages, samplesPerBlock);
+    
+    // Low and Low-Mid sections redesigned for the reduced rate
+    juce::dsp::ProcessSpec reducedSpec { reducedRate, (juce::uint32) samplesPerBlock, 1 };
+    const auto designed = makeBandCoefficients(reducedRate);
+    lowPassFiltersReduced.resize((size_t) numChannels);
+    lowMidFiltersReduced.resize((size_t) numChannels);
+    for (int c = 0; c < numChannels; ++c)
+    {
+        auto& low = lowPassFiltersReduced[(size_t) c];
+        auto& lowMid = lowMidFiltersReduced[(size_t) c];
+        low.prepare(reducedSpec);
+        lowMid.prepare(reducedSpec);
+        *low.get<0>().coefficients = *designed[0];
+        *low.get<1>().coefficients = *designed[1];
+        *lowMid.get<0>().coefficients = *designed[2];
+        *lowMid.get<1>().coefficients = *designed[3];
+        low.reset();
+        lowMid.reset();
+    }
+    
+    dcBlockerRReduced = (float) std::exp(-2.0 * juce::MathConstants<double>::pi * 5.0 / reducedRate);
+    dcPrevXLowReduced.assign((size_t) numChannels, 0.0f);
+    dcPrevYLowReduced.assign((size_t) numChannels, 0.0f);
+    
+    multirateActive = false; // re-evaluated (and state reset) by updateMultirateSettings()
+}
+
+void EQIsolator4AudioProcessor::updateMultirateSettings()
+{
+    const bool wanted = multirateParam->get() && multirateStages > 0 && ! highQualityActive;
+    
+    // The kernel skips the full-rate Low/Low-Mid lanes the branch replaces
+    core.setUpperBandsOnly(wanted);
+    if (wanted == multirateActive)
+        return;
+    
+    // The split changes shape and delay either way: primed before this block's split
+    multirateActive = wanted;
+    splitNeedsPrime = true;
+    updateLatency();
+}
+
+void EQIsolator4AudioProcessor::resetMultirate()
+{
+    for (auto& branch : multirateBranches)
+        branch.reset();
+    for (auto& chain : lowPassFiltersReduced)
+        chain.reset();
+    for (auto& chain : lowMidFiltersReduced)
+        chain.reset();
+    std::fill(dcPrevXLowReduced.begin(), dcPrevXLowReduced.end(), 0.0f);
+    std::fill(dcPrevYLowReduced.begin(), dcPrevYLowReduced.end(), 0.0f);
 }
 
-void EQIsolator4AudioProcessor::updateFilters()
+void EQIsolator4AudioProcessor::updateHighQualitySettings()
 {
-    // Filter update with coefficient caching
+    const bool wanted = isNonRealtime() && offlineHqParam->get() && preparedNumChannels > 0;
     
-    const auto sampleRate = processSpec.sampleRate;
+    // prepareToPlay() builds the engine when preparing for an offline render; only a host that
+    // switches to offline without preparing again gets it built here (offline, so no deadline)
+    if (wanted && ! highQualityEngine.isPreparedFor(preparedSampleRate, preparedNumChannels))
+    {
+        highQualityEngine.prepare(preparedSampleRate, preparedBlockSize, preparedNumChannels);
+        highQualityActive = false;
+        prepareHostBypass(); // the engine's latency is only known now
+    }
     
-    static thread_local double lastSampleRate = 0.0;
-    static thread_local auto cachedLowPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeLowPass(44100.0, LOW_LOWMID_CROSSOVER_FREQ);
-    static thread_local auto cachedLowMidHighPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeHighPass(44100.0, LOW_LOWMID_CROSSOVER_FREQ);
-    static thread_local auto cachedLowMidLowPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeLowPass(44100.0, LOWMID_MID_CROSSOVER_FREQ);
-    static thread_local auto cachedMidHighPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeHighPass(44100.0, LOWMID_MID_CROSSOVER_FREQ);
-    static thread_local auto cachedMidLowPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeLowPass(44100.0, MID_HIGH_CROSSOVER_FREQ);
-    static thread_local auto cachedHighPassCoeff = 
-        juce::dsp::IIR::Coefficients<float>::makeHighPass(44100.0, MID_HIGH_CROSSOVER_FREQ);
+    if (wanted == highQualityActive)
+        return;
     
-    // Only recalculate coefficients if sample rate changed
-    if (sampleRate != lastSampleRate)
+    // Whichever split takes over sat idle: it is primed before this block's split
+    highQualityActive = wanted;
+    splitNeedsPrime = true;
+    updateLatency();
+}
+
+void EQIsolator4AudioProcessor::processMultirateLowBands(int channel, const float* input,
+                                                         float* lowData, float* lowMidData, int numSamples)
+{
+    auto& branch = multirateBranches[(size_t) channel];
+    const int maxChunk = juce::jmax(1, preparedBlockSize);
+    
+    for (int start = 0; start < numSamples; start += maxChunk)
     {
-        lastSampleRate = sampleRate;
+        const int n = juce::jmin(maxChunk, numSamples - start);
+        const int reduced = branch.decimate(input + start, n);
         
-        // Recalculate all coefficients for new sample rate
-        cachedLowPassCoeff = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, LOW_LOWMID_CROSSOVER_FREQ);
-        cachedLowMidHighPassCoeff = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, LOW_LOWMID_CROSSOVER_FREQ);
-        cachedLowMidLowPassCoeff = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, LOWMID_MID_CROSSOVER_FREQ);
-        cachedMidHighPassCoeff = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, LOWMID_MID_CROSSOVER_FREQ);
-        cachedMidLowPassCoeff = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, MID_HIGH_CROSSOVER_FREQ);
-        cachedHighPassCoeff = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, MID_HIGH_CROSSOVER_FREQ);
+        if (reduced > 0)
+        {
+            float* low = branch.getReducedBand(0);
+            float* lowMid = branch.getReducedBand(1);
+            
+            juce::dsp::AudioBlock<float> lowBlock(&low, 1, (size_t) reduced);
+            lowPassFiltersReduced[(size_t) channel].process(juce::dsp::ProcessContextReplacing<float>(lowBlock));
+            applyDcBlocker(low, reduced, dcBlockerRReduced, dcPrevXLowReduced[(size_t) channel], dcPrevYLowReduced[(size_t) channel]);
+            
+            juce::dsp::AudioBlock<float> lowMidBlock(&lowMid, 1, (size_t) reduced);
+            lowMidFiltersReduced[(size_t) channel].process(juce::dsp::ProcessContextReplacing<float>(lowMidBlock));
+        }
+        
+        branch.interpolate(reduced, lowData + start, lowMidData + start, n);
+    }
+}
+
+void EQIsolator4AudioProcessor::applyDcBlocker(float* data, int numSamples, float r, float& prevXState, float& prevYState) noexcept
+{
+    float prevX = prevXState;
+    float prevY = prevYState;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = data[i];
+        const float y = data[i] - prevX + r * prevY; // H(z) = 1 - z^-1 / 1 - r z^-1
+        data[i] = y;
+        prevX = x;
+        prevY = y;
     }
+    prevXState = prevX;
+    prevYState = prevY;
+}
+
+int EQIsolator4AudioProcessor::getRequestedLookaheadSamples() const
+{
+    const int lookahead = juce::roundToInt(limiterLookaheadParam->get() * 0.001 * processSpec.sampleRate);
+    return juce::jlimit(0, outputLimiter.getMaxLookaheadSamples(), lookahead);
+}
+
+void EQIsolator4AudioProcessor::applyLimiterLookahead()
+{
+    // Prepare time only: a new look-ahead restarts the limiters
+    const int lookahead = getRequestedLookaheadSamples();
+    if (lookahead == limiterLookaheadSamples)
+        return;
     
-    // Apply cached coefficients to all filter chains
-    // Low band: 20 Hz - 200 Hz (Low Pass at 200Hz)
-    for (auto& chain : lowPassFilters)
+    for (auto& limiter : bandLimiters)
+        limiter.setLookaheadSamples(lookahead);
+    outputLimiter.setLookaheadSamples(lookahead);
+    limiterLookaheadSamples = outputLimiter.getLookaheadSamples();
+    limiterModeActive = -1; // re-align band bus delays and report the latency
+}
+
+void EQIsolator4AudioProcessor::handleAsyncUpdate()
+{
+    // Look-ahead changed: report the latency it will have once applied. Hosts respond by
+    // re-preparing, which applies it; otherwise it waits for the next prepareToPlay()
+    if (limiterStages <= 0 || preparedSampleRate <= 0.0)
+        return;
+    
+    const int latency = getLatencySamples() + limiterStages * (getRequestedLookaheadSamples() - limiterLookaheadSamples);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void EQIsolator4AudioProcessor::updateLimiterSettings()
+{
+    const int mode = limiterModeParam->getIndex();
+    const int stages = (mode == limiterOutput || mode == limiterPerBand) ? 1
+                     : (mode == limiterPerBandAndOutput ? 2 : 0);
+
+    if (mode != limiterModeActive || stages != limiterStages)
+    {
+        // Limiters left idle restart from a clean state when they come back
+        const bool bandsActive = (mode == limiterPerBand || mode == limiterPerBandAndOutput);
+        const bool outputActive = (mode == limiterOutput || mode == limiterPerBandAndOutput);
+        if (! bandsActive)
+            for (auto& limiter : bandLimiters)
+                limiter.reset();
+        if (! outputActive)
+            outputLimiter.reset();
+
+        for (auto& delay : bandBusDelays)
+        {
+            delay.reset();
+            delay.setDelay(outputActive ? (float) limiterLookaheadSamples : 0.0f);
+        }
+
+        limiterModeActive = mode;
+        limiterStages = stages;
+        updateLatency();
+    }
+
+    const float ceilingDb = limiterCeilingParam->get();
+    if (ceilingDb != lastLimiterCeilingDb)
     {
-        *chain.get<0>().coefficients = *cachedLowPassCoeff;
-        *chain.get<1>().coefficients = *cachedLowPassCoeff; // Second-order for steeper cutoff
+        lastLimiterCeilingDb = ceilingDb;
+        for (auto& limiter : bandLimiters)
+            limiter.setCeilingDecibels(ceilingDb);
+        outputLimiter.setCeilingDecibels(ceilingDb);
     }
+
+    const float releaseMs = limiterReleaseParam->get();
+    if (releaseMs != lastLimiterReleaseMs)
+    {
+        lastLimiterReleaseMs = releaseMs;
+        for (auto& limiter : bandLimiters)
+            limiter.setReleaseMs(releaseMs);
+        outputLimiter.setReleaseMs(releaseMs);
+    }
+}
+
+std::array<juce::dsp::IIR::Coefficients<float>::Ptr, 8> EQIsolator4AudioProcessor::makeBandCoefficients(double sampleRate)
+{
+    // Two sections per band, in processing order, exactly as the core designs them
+    // (shared with the response display and the multirate branch)
+    const auto sections = IsolatorCore::designSections(sampleRate, LOW_LOWMID_CROSSOVER_FREQ,
+                                                       LOWMID_MID_CROSSOVER_FREQ, MID_HIGH_CROSSOVER_FREQ);
     
-    // Low-Mid band: 200 Hz - 750 Hz (High Pass at 200Hz + Low Pass at 750Hz)
-    for (auto& chain : lowMidFilters)
+    std::array<juce::dsp::IIR::Coefficients<float>::Ptr, 8> coefficients;
+    for (size_t i = 0; i < sections.size(); ++i)
     {
-        *chain.get<0>().coefficients = *cachedLowMidHighPassCoeff;
-        *chain.get<1>().coefficients = *cachedLowMidLowPassCoeff;
+        const auto& c = sections[i];
+        coefficients[i] = new juce::dsp::IIR::Coefficients<float>(c[0], c[1], c[2], 1.0f, c[3], c[4]);
     }
+    return coefficients;
+}
+
+void EQIsolator4AudioProcessor::pushCoreParameters() noexcept
+{
+    core.setParameter(IsolatorCore::lowGain, lowGainParam->get());
+    core.setParameter(IsolatorCore::lowMidGain, lowMidGainParam->get());
+    core.setParameter(IsolatorCore::midGain, midGainParam->get());
+    core.setParameter(IsolatorCore::highGain, highGainParam->get());
+    core.setParameter(IsolatorCore::lowBypass, lowBypassParam->get() ? 1.0f : 0.0f);
+    core.setParameter(IsolatorCore::lowMidBypass, lowMidBypassParam->get() ? 1.0f : 0.0f);
+    core.setParameter(IsolatorCore::midBypass, midBypassParam->get() ? 1.0f : 0.0f);
+    core.setParameter(IsolatorCore::highBypass, highBypassParam->get() ? 1.0f : 0.0f);
     
-    // Mid band: 750 Hz - 3000 Hz (High Pass at 750Hz + Low Pass at 3000Hz)
-    for (auto& chain : midFilters)
+    for (int band = 0; band < NUM_BANDS; ++band)
     {
-        *chain.get<0>().coefficients = *cachedMidHighPassCoeff;
-        *chain.get<1>().coefficients = *cachedMidLowPassCoeff;
+        const auto parameter = [band](IsolatorCore::Parameter first) { return (IsolatorCore::Parameter) (first + band); };
+        core.setParameter(parameter(IsolatorCore::lowDynamicsMode), (float) dynamicsModeParams[(size_t) band]->getIndex());
+        core.setParameter(parameter(IsolatorCore::lowThreshold), dynamicsThresholdParams[(size_t) band]->get());
+        core.setParameter(parameter(IsolatorCore::lowRatio), dynamicsRatioParams[(size_t) band]->get());
+        core.setParameter(parameter(IsolatorCore::lowAttack), dynamicsAttackParams[(size_t) band]->get());
+        core.setParameter(parameter(IsolatorCore::lowRelease), dynamicsReleaseParams[(size_t) band]->get());
     }
+    core.setParameter(IsolatorCore::dynamicsRange, dynamicsRangeParam->get());
     
-    // High band: 3000 Hz - 20 kHz (High Pass at 3000Hz)
-    for (auto& chain : highPassFilters)
+    core.setParameter(IsolatorCore::stereoMode, (float) stereoModeParam->getIndex());
+    for (int band = 0; band < NUM_BANDS; ++band)
     {
-        *chain.get<0>().coefficients = *cachedHighPassCoeff;
-        *chain.get<1>().coefficients = *cachedHighPassCoeff; // Second-order for steeper cutoff
+        core.setParameter((IsolatorCore::Parameter) (IsolatorCore::lowSideGain + band), sideGainParams[(size_t) band]->get());
+        core.setParameter((IsolatorCore::Parameter) (IsolatorCore::lowSideBypass + band), sideBypassParams[(size_t) band]->get() ? 1.0f : 0.0f);
     }
 }
 
@@ -315,6 +641,14 @@ bool EQIsolator4AudioProcessor::isBusesLayoutSupported(const BusesLayout& layout
         return false;
    #endif
 
+    // Band buses are either disabled or mirror the main output layout
+    for (int bus = 1; bus < layouts.outputBuses.size(); ++bus)
+    {
+        const auto& set = layouts.getChannelSet(false, bus);
+        if (! set.isDisabled() && set != layouts.getMainOutputChannelSet())
+            return false;
+    }
+
     return true;
   #endif
 }
@@ -324,6 +658,10 @@ void EQIsolator4AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 {
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
+    EQ4_PROFILE_SCOPE("processBlock");
+    
+    // Block cost is measured for the governor from here to every return
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
     
     const int totalNumInputChannels = getTotalNumInputChannels();
     const int totalNumOutputChannels = getTotalNumOutputChannels();
@@ -333,131 +671,423 @@ void EQIsolator4AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, numSamples);
     
-    const float lowGain = lowGainParam->get();
-    const float lowMidGain = lowMidGainParam->get();
-    const float midGain = midGainParam->get();
-    const float highGain = highGainParam->get();
+    if (flightRecorder.isEnabled())
+        recordFlightInput(buffer, totalNumInputChannels);
     
-    const bool lowBypass = lowBypassParam->get();
-    const bool lowMidBypass = lowMidBypassParam->get();
-    const bool midBypass = midBypassParam->get();
-    const bool highBypass = highBypassParam->get();
+    // Gain/bypass/dynamics targets for the core
+    pushCoreParameters();
     
-    const bool allBandsAtZero = (lowGain == 0.0f && lowMidGain == 0.0f && 
-                                midGain == 0.0f && highGain == 0.0f) &&
-                               (!lowBypass && !lowMidBypass && !midBypass && !highBypass);
+    // Limiter settings may change latency, so they are applied before the bypass shortcuts
+    updateLimiterSettings();
     
-    if (allBandsAtZero)
+    // Offline engine and multirate low branch (both change latency)
+    updateHighQualitySettings();
+    updateMultirateSettings();
+    
+    // Stereo mode: the core converts its own split state; the multirate branch and the
+    // offline engine hold the other domain, so they are primed in the new one
+    const bool midSide = core.isMidSideActive() && juce::jmin(totalNumInputChannels, core.getNumChannels()) >= 2;
+    if (midSide != midSideWasActive)
     {
-        // Perfect transparency - pass through unprocessed
+        if (multirateActive || highQualityActive)
+            splitNeedsPrime = true;
+        midSideWasActive = midSide;
+    }
+    
+    // Analysis starts from a fresh window and position each time it is switched on
+    const int analysis = analysisMode.load(std::memory_order_relaxed);
+    if (analysis != analysisModeActive)
+    {
+        if (analysisModeActive == analysisOff)
+            bandAnalyzer.reset();
+        analysisModeActive = analysis;
+    }
+    
+    // Host bypass: the input history is both the dry signal and the re-priming material
+    hostBypass.pushInput(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples);
+    const auto bypassMode = hostBypass.update(bypassParam->get(), numSamples);
+    
+    if (bypassMode == HostBypass::bypassed)
+    {
+        renderBypassed(buffer, totalNumInputChannels, numSamples);
+        finishBlock(blockStartTicks, numSamples);
         return;
     }
     
-    // Smooth in dB domain (less sensitivity around 0 dB). No deadband to avoid under-tracking.
-    smoothedLowGain.setTargetValue(lowGain);
-    smoothedLowMidGain.setTargetValue(lowMidGain);
-    smoothedMidGain.setTargetValue(midGain);
-    smoothedHighGain.setTargetValue(highGain);
+    // Priming is a one-off on top of this block's work, kept out of the governor's timing
+    if (hostBypass.isLeavingBypass() || splitNeedsPrime)
+    {
+        const auto primeStartTicks = juce::Time::getHighResolutionTicks();
+        if (hostBypass.isLeavingBypass())
+            primeAfterBypass(totalNumInputChannels, numSamples);
+        else
+            primeSplit(totalNumInputChannels);
+        primeTicks = juce::Time::getHighResolutionTicks() - primeStartTicks;
+    }
+    splitNeedsPrime = false;
     
-    // Bypass smoothing for all bands
-    smoothedLowBypass.setTargetValue(lowBypass ? 0.0f : 1.0f);
-    smoothedLowMidBypass.setTargetValue(lowMidBypass ? 0.0f : 1.0f);
-    smoothedMidBypass.setTargetValue(midBypass ? 0.0f : 1.0f);
-    smoothedHighBypass.setTargetValue(highBypass ? 0.0f : 1.0f);
+    const int numDryChannels = juce::jmin(totalNumInputChannels, bypassDryBuffer.getNumChannels());
+    if (bypassMode == HostBypass::crossfading)
+    {
+        bypassDryBuffer.setSize(bypassDryBuffer.getNumChannels(), numSamples, false, false, true);
+        hostBypass.readDelayed(bypassDryBuffer.getArrayOfWritePointers(), numDryChannels, numSamples, getLatencySamples());
+    }
     
-    // No dynamic filter recalc in processBlock
+    processBands(buffer, totalNumInputChannels, numSamples, true);
     
-    // Precompute per-sample control curves once (used for all channels)
+    if (bypassMode == HostBypass::crossfading)
     {
-        auto ensureSize = [numSamples](std::vector<float>& v) { if ((int)v.size() < numSamples) v.resize(numSamples); };
-        ensureSize(lowGainCurve); ensureSize(lowMidGainCurve); ensureSize(midGainCurve); ensureSize(highGainCurve);
-        ensureSize(lowBypassCurve); ensureSize(lowMidBypassCurve); ensureSize(midBypassCurve); ensureSize(highBypassCurve);
+        hostBypass.crossfade(buffer.getArrayOfWritePointers(), bypassDryBuffer.getArrayOfReadPointers(), numDryChannels, numSamples);
+        
+        // Band buses carry nothing while bypassed, so they fade with the processed signal
+        for (int channel = totalNumInputChannels; channel < buffer.getNumChannels(); ++channel)
+            hostBypass.applyFade(buffer.getWritePointer(channel), numSamples);
+    }
+    
+    finishBlock(blockStartTicks, numSamples);
+}
 
-        // Generate curves
-        for (int i = 0; i < numSamples; ++i)
-        {
-            lowGainCurve[i]     = juce::Decibels::decibelsToGain(smoothedLowGain.getNextValue());
-            lowMidGainCurve[i]  = juce::Decibels::decibelsToGain(smoothedLowMidGain.getNextValue());
-            midGainCurve[i]     = juce::Decibels::decibelsToGain(smoothedMidGain.getNextValue());
-            highGainCurve[i]    = juce::Decibels::decibelsToGain(smoothedHighGain.getNextValue());
-
-            auto smoothStep = [](float x) noexcept { x = juce::jlimit(0.0f, 1.0f, x); return x * x * (3.0f - 2.0f * x); };
-            lowBypassCurve[i]    = smoothStep(smoothedLowBypass.getNextValue());
-            lowMidBypassCurve[i] = smoothStep(smoothedLowMidBypass.getNextValue());
-            midBypassCurve[i]    = smoothStep(smoothedMidBypass.getNextValue());
-            highBypassCurve[i]   = smoothStep(smoothedHighBypass.getNextValue());
-        }
+void EQIsolator4AudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Only hosts that ignore getBypassParameter() call this: same dry path, and
+    // processBlock() re-primes and fades back in when they resume
+    juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(midiMessages);
+    
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+    const int totalNumInputChannels = getTotalNumInputChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    for (int i = totalNumInputChannels; i < getTotalNumOutputChannels(); ++i)
+        buffer.clear(i, 0, numSamples);
+    
+    if (flightRecorder.isEnabled())
+        recordFlightInput(buffer, totalNumInputChannels);
+    
+    hostBypass.pushInput(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples);
+    hostBypass.setBypassed();
+    renderBypassed(buffer, totalNumInputChannels, numSamples);
+    finishBlock(blockStartTicks, numSamples);
+}
+
+void EQIsolator4AudioProcessor::prepareHostBypass()
+{
+    // Longest latency this spec can report: both limiters at full look-ahead plus the slower split
+    const int splitLatency = juce::jmax(MultirateLowBranch::getLatencyForStages(multirateStages),
+                                        highQualityEngine.getLatencySamples());
+    const int maximumDelay = 2 * outputLimiter.getMaxLookaheadSamples() + splitLatency;
+    
+    hostBypass.prepare(preparedSampleRate, preparedBlockSize, preparedNumChannels, maximumDelay);
+    bypassDryBuffer.setSize(preparedNumChannels, preparedBlockSize);
+    bypassPrimeBuffer.setSize(juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()), preparedBlockSize);
+}
+
+void EQIsolator4AudioProcessor::renderBypassed(juce::AudioBuffer<float>& buffer, int numInputChannels, int numSamples)
+{
+    // The input passes through, delayed by the reported latency so the host's compensation
+    // still lines up (in place: with no latency there is nothing to do); band buses stay cleared
+    const int latency = getLatencySamples();
+    if (latency > 0)
+        hostBypass.readDelayed(buffer.getArrayOfWritePointers(), numInputChannels, numSamples, latency);
+    
+    for (auto& gain : displayBandGains)
+        gain.store(1.0f, std::memory_order_relaxed);
+    telemetry.bypassedBlocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EQIsolator4AudioProcessor::primeAfterBypass(int numInputChannels, int numSamples)
+{
+    // The chain sat idle while bypassed. Start it clean and run it over the input just
+    // before this block (output discarded), so the filters, limiter look-ahead and delays
+    // hold the recent signal rather than a jump from silence when the crossfade brings it in.
+    // At most maxPrimeBlocks blocks' worth, so this callback costs a bounded multiple of a
+    // normal one; the crossfade, which starts from the dry signal, covers the rest.
+    EQ4_PROFILE_SCOPE("bypass prime");
+    resetProcessingState();
+    
+    const int available = hostBypass.getPrimeLength();
+    const int length = juce::jmin(available, maxPrimeBlocks * numSamples);
+    const int chunk = juce::jmax(1, preparedBlockSize);
+    for (int start = available - length; start < available; start += chunk)
+    {
+        const int n = juce::jmin(chunk, available - start);
+        bypassPrimeBuffer.setSize(bypassPrimeBuffer.getNumChannels(), n, false, false, true);
+        bypassPrimeBuffer.clear();
+        hostBypass.readPrime(bypassPrimeBuffer.getArrayOfWritePointers(), numInputChannels, start, n);
+        processBands(bypassPrimeBuffer, numInputChannels, n, false);
+    }
+}
+
+void EQIsolator4AudioProcessor::primeSplit(int numInputChannels)
+{
+    // The live split, the multirate branch and the offline engine hand over the same way in
+    // every direction: the split taking over starts clean and runs over the input just before
+    // this block (bands discarded), so it comes in warm, with the multirate delay already
+    // full. Only the split changes hands; the dynamics, limiters and delays carry on.
+    EQ4_PROFILE_SCOPE("split prime");
+    if (highQualityActive)
+    {
+        highQualityEngine.reset();
+    }
+    else
+    {
+        core.resetSplit();
+        if (multirateActive)
+            resetMultirate();
+    }
+    
+    const int numSplitChannels = juce::jmin(numInputChannels, core.getNumChannels());
+    const bool midSide = core.isMidSideActive() && numSplitChannels >= 2;
+    
+    const int length = hostBypass.getPrimeLength();
+    const int chunk = juce::jmax(1, preparedBlockSize);
+    for (int start = 0; start < length; start += chunk)
+    {
+        const int n = juce::jmin(chunk, length - start);
+        bypassPrimeBuffer.setSize(bypassPrimeBuffer.getNumChannels(), n, false, false, true);
+        bypassPrimeBuffer.clear();
+        hostBypass.readPrime(bypassPrimeBuffer.getArrayOfWritePointers(), numInputChannels, start, n);
+        
+        if (midSide)
+            IsolatorCore::encodeMidSide(bypassPrimeBuffer.getWritePointer(0), bypassPrimeBuffer.getWritePointer(1), n);
+        
+        splitInput(bypassPrimeBuffer.getArrayOfReadPointers(), numSplitChannels, n);
     }
+}
 
-    // Process each channel
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+void EQIsolator4AudioProcessor::resetProcessingState()
+{
+    core.reset();
+    for (auto& limiter : bandLimiters)
+        limiter.reset();
+    outputLimiter.reset();
+    for (auto& delay : bandBusDelays)
+        delay.reset();
+    
+    if (multirateActive)
+        resetMultirate();
+    if (highQualityActive)
+        highQualityEngine.reset();
+}
+
+void EQIsolator4AudioProcessor::splitInput(const float* const* inputs, int numSplitChannels, int numSamples)
+{
+    if (highQualityActive)
     {
-        // Use persistent temp buffers for each band
-        juce::AudioBuffer<float>& lowBuffer = lowTempBuffers[channel];
-        juce::AudioBuffer<float>& lowMidBuffer = lowMidTempBuffers[channel];
-        juce::AudioBuffer<float>& midBuffer = midTempBuffers[channel];
-        juce::AudioBuffer<float>& highBuffer = highTempBuffers[channel];
-        if (lowBuffer.getNumSamples() < numSamples)
+        // Offline render: the whole split runs in the high-quality engine
+        EQ4_PROFILE_SCOPE("HQ split");
+        highQualityEngine.process(inputs, numSplitChannels, numSamples, core.getBandOutputs());
+    }
+    else if (! multirateActive)
+    {
+        core.splitBands(inputs, numSplitChannels, numSamples);
+    }
+    else
+    {
+        // The full-rate bands see the input delayed to match the reduced-rate branch
         {
-            lowBuffer.setSize(1, numSamples, false, false, true);
-            lowMidBuffer.setSize(1, numSamples, false, false, true);
-            midBuffer.setSize(1, numSamples, false, false, true);
-            highBuffer.setSize(1, numSamples, false, false, true);
+            EQ4_PROFILE_SCOPE("multirate delay");
+            for (int channel = 0; channel < numSplitChannels; ++channel)
+                multirateBranches[(size_t) channel].delay(inputs[channel], core.getBandData(2, channel), numSamples);
         }
         
-        // Copy input data to each band buffer
-        lowBuffer.copyFrom(0, 0, buffer, channel, 0, numSamples);
-        lowMidBuffer.copyFrom(0, 0, buffer, channel, 0, numSamples);
-        midBuffer.copyFrom(0, 0, buffer, channel, 0, numSamples);
-        highBuffer.copyFrom(0, 0, buffer, channel, 0, numSamples);
+        // Mid/High only, in place on the delayed input (the core is set to upper bands
+        // while multirate is on); Low/Low-Mid come from the reduced-rate branch
+        const float* delayedInputs[MAX_CHANNELS] = {};
+        for (int channel = 0; channel < numSplitChannels; ++channel)
+            delayedInputs[channel] = core.getBandData(2, channel);
+        core.splitBands(delayedInputs, numSplitChannels, numSamples);
         
-        // Get pointers for processing
-        float* lowData = lowBuffer.getWritePointer(0);
-        float* lowMidData = lowMidBuffer.getWritePointer(0);
-        float* midData = midBuffer.getWritePointer(0);
-        float* highData = highBuffer.getWritePointer(0);
+        EQ4_PROFILE_SCOPE("multirate low bands");
+        for (int channel = 0; channel < numSplitChannels; ++channel)
+            processMultirateLowBands(channel, inputs[channel],
+                                     core.getBandData(0, channel), core.getBandData(1, channel), numSamples);
+    }
+}
+
+void EQIsolator4AudioProcessor::processBands(juce::AudioBuffer<float>& buffer, int numInputChannels, int numSamples, bool measure)
+{
+    // Neutral also waits for the dynamics to release, so a band switched off never stops mid-reduction
+    const bool allBandsAtZero = core.isNeutral();
+    const int limiterMode = limiterModeActive;
+    
+    if (allBandsAtZero && limiterMode == limiterOff && numBandBusesEnabled == 0 && ! multirateActive && ! highQualityActive
+        && analysisModeActive == analysisOff)
+    {
+        for (auto& gain : displayBandGains)
+            gain.store(1.0f, std::memory_order_relaxed);
         
-        // Low band
-        juce::dsp::AudioBlock<float> lowBlock(&lowData, 1, numSamples);
-        lowPassFilters[channel].process(juce::dsp::ProcessContextReplacing<float>(lowBlock));
-        // Apply lightweight DC blocker to low band to avoid pops on transitions
+        // Perfect transparency - pass through unprocessed
+        return;
+    }
+    
+    // Governor tiers for the core; the curves advance once per block
+    core.setCoarseControl(governorTier >= CpuGovernor::tierCoarseControl);
+    core.setReducedSlopes(governorTier >= CpuGovernor::tierReducedSlopes);
+    core.computeControlCurves(numSamples);
+    
+    // Band outputs of every split path: the core's band buffers
+    const int numSplitChannels = juce::jmin(numInputChannels, core.getNumChannels());
+    float* const* const* const bandOutputs = core.getBandOutputs();
+    
+    // Mid/side: encoded once, in place, so every split path (and the multirate delay) sees
+    // it; the mix decodes. Analysis-only must leave the input alone, so it encodes a copy and
+    // measures the same mid/side bands as analysis alongside processing.
+    const bool midSide = core.isMidSideActive() && numSplitChannels >= 2;
+    const float* splitInputs[MAX_CHANNELS] = {};
+    for (int channel = 0; channel < numSplitChannels; ++channel)
+        splitInputs[channel] = buffer.getReadPointer(channel);
+    
+    if (midSide)
+    {
+        EQ4_PROFILE_SCOPE("mid/side encode");
+        if (analysisModeActive == analysisOnly)
         {
-            float prevX = dcPrevXLow[channel];
-            float prevY = dcPrevYLow[channel];
-            const float r = dcBlockerR;
-            for (int i = 0; i < numSamples; ++i)
+            for (int channel = 0; channel < 2; ++channel)
             {
-                const float x = lowData[i];
-                const float y = lowData[i] - prevX + r * prevY; // H(z) = 1 - z^-1 / 1 - r z^-1
-                lowData[i] = y;
-                prevX = x;
-                prevY = y;
+                analysisInputBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+                splitInputs[channel] = analysisInputBuffer.getReadPointer(channel);
             }
-            dcPrevXLow[channel] = prevX;
-            dcPrevYLow[channel] = prevY;
+            IsolatorCore::encodeMidSide(analysisInputBuffer.getWritePointer(0), analysisInputBuffer.getWritePointer(1), numSamples);
         }
+        else
+        {
+            IsolatorCore::encodeMidSide(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
+        }
+    }
+    
+    splitInput(splitInputs, numSplitChannels, numSamples);
+    if (! highQualityActive)
+        countSplit();
+    
+    // Analysis measures the split as it comes out. Analysis-only passes the input through,
+    // delayed like the bypass by the latency still reported for the limiters and the split,
+    // so the host's compensation lines up and toggling the mode doesn't move the signal.
+    if (measure && analysisModeActive != analysisOff)
+        core.analyzeBands(bandAnalyzer, numSplitChannels, numSamples);
+    if (analysisModeActive == analysisOnly)
+    {
+        const int latency = getLatencySamples();
+        if (latency > 0)
+            hostBypass.readDelayed(buffer.getArrayOfWritePointers(), numInputChannels, numSamples, latency);
+        return;
+    }
+    
+    // Band dynamics detect on the split bands and fold into the gain curves, so
+    // the mix, the per-band limiters and the band buses all see them
+    core.applyDynamics(numSplitChannels, numSamples);
+    
+    // Publish where the smoothers ended up (read by the response display)
+    if (numSamples > 0)
+    {
+        for (int band = 0; band < NUM_BANDS; ++band)
+            displayBandGains[(size_t) band].store(core.getGainCurve(band)[numSamples - 1] * core.getBypassCurve(band)[numSamples - 1],
+                                                  std::memory_order_relaxed);
+    }
+    
+    if (limiterMode == limiterPerBand || limiterMode == limiterPerBandAndOutput)
+    {
+        // Per-band limiting needs the gained band signals of all channels (linked detection)
+        core.applyBandGains(numSplitChannels, numSamples);
         
-        // Low-Mid band
-        juce::dsp::AudioBlock<float> lowMidBlock(&lowMidData, 1, numSamples);
-        lowMidFilters[channel].process(juce::dsp::ProcessContextReplacing<float>(lowMidBlock));
-        
-        // Mid band
-        juce::dsp::AudioBlock<float> midBlock(&midData, 1, numSamples);
-        midFilters[channel].process(juce::dsp::ProcessContextReplacing<float>(midBlock));
+        {
+            EQ4_PROFILE_SCOPE("band limiters");
+            for (int band = 0; band < NUM_BANDS; ++band)
+                bandLimiters[band].process(bandOutputs[band], numSplitChannels, numSamples);
+        }
         
-        // High band  
-        juce::dsp::AudioBlock<float> highBlock(&highData, 1, numSamples);
-        highPassFilters[channel].process(juce::dsp::ProcessContextReplacing<float>(highBlock));
-        float* channelData = buffer.getWritePointer(channel);
+        core.sumBands(buffer.getArrayOfWritePointers(), numSplitChannels, numSamples);
+    }
+    else
+    {
+        core.mixBands(buffer.getArrayOfWritePointers(), numSplitChannels, numSamples);
+    }
+    
+    // Per-band output buses: written from the same split with gain/bypass applied (left/right)
+    if (numBandBusesEnabled > 0)
+    {
+        EQ4_PROFILE_SCOPE("band buses");
+        const bool bandsAlreadyGained = (limiterMode == limiterPerBand || limiterMode == limiterPerBandAndOutput);
+        const bool alignToOutputLimiter = (limiterMode == limiterOutput || limiterMode == limiterPerBandAndOutput);
         
-        for (int i = 0; i < numSamples; ++i)
+        for (int band = 0; band < NUM_BANDS; ++band)
         {
-            channelData[i] = (lowData[i]     * lowGainCurve[i]    * lowBypassCurve[i]) +
-                             (lowMidData[i]  * lowMidGainCurve[i] * lowMidBypassCurve[i]) +
-                             (midData[i]     * midGainCurve[i]    * midBypassCurve[i]) +
-                             (highData[i]    * highGainCurve[i]   * highBypassCurve[i]);
+            auto* bus = getBus(false, band + 1);
+            if (bus == nullptr || ! bus->isEnabled())
+                continue;
+            
+            const int firstChannel = getChannelIndexInProcessBlockBuffer(false, band + 1, 0);
+            const int numBusChannels = juce::jmin(bus->getNumberOfChannels(), numSplitChannels,
+                                                  buffer.getNumChannels() - firstChannel);
+            
+            if (numBusChannels > 0)
+                core.renderBand(band, buffer.getArrayOfWritePointers() + firstChannel, numBusChannels, numSamples, bandsAlreadyGained);
+            
+            if (alignToOutputLimiter && numBusChannels > 0)
+            {
+                juce::dsp::AudioBlock<float> busBlock(buffer.getArrayOfWritePointers() + firstChannel,
+                                                      (size_t) numBusChannels, (size_t) numSamples);
+                bandBusDelays[band].process(juce::dsp::ProcessContextReplacing<float>(busBlock));
+            }
         }
     }
+    
+    // Brickwall on the summed output
+    if (limiterMode == limiterOutput || limiterMode == limiterPerBandAndOutput)
+    {
+        EQ4_PROFILE_SCOPE("output limiter");
+        outputLimiter.process(buffer.getArrayOfWritePointers(), numInputChannels, numSamples);
+    }
+}
+
+void EQIsolator4AudioProcessor::countSplit()
+{
+    // Share of dual-mono blocks, for tooling (only the core split links channels)
+    telemetry.splitBlocks.fetch_add(1, std::memory_order_relaxed);
+    if (core.wasLastSplitLinked())
+        telemetry.linkedSplitBlocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EQIsolator4AudioProcessor::recordFlightInput(const juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    // Normalised values of every parameter, in the order the capture's IDs were listed
+    const auto& parameters = getParameters();
+    const int numParameters = juce::jmin(parameters.size(), FlightRecorder::maxParameters);
+    float values[FlightRecorder::maxParameters];
+    for (int i = 0; i < numParameters; ++i)
+        values[i] = parameters.getUnchecked(i)->getValue();
+    
+    flightRecorder.recordInput(buffer.getArrayOfReadPointers(), numChannels, buffer.getNumSamples(),
+                               values, numParameters, isNonRealtime());
+}
+
+void EQIsolator4AudioProcessor::finishBlock(juce::int64 blockStartTicks, int numSamples)
+{
+    // The governor sees the block without priming (a one-off, not load); the recorder sees it all
+    const auto ticks = juce::Time::getHighResolutionTicks() - blockStartTicks;
+    const double elapsed = juce::Time::highResolutionTicksToSeconds(ticks);
+    updateGovernor(juce::Time::highResolutionTicksToSeconds(ticks - primeTicks), numSamples);
+    primeTicks = 0;
+    
+    if (flightRecorder.isEnabled())
+        flightRecorder.recordTiming(elapsed, governorTier);
+}
+
+void EQIsolator4AudioProcessor::updateGovernor(double elapsed, int numSamples)
+{
+    // Offline renders have no deadline; the governor only acts live
+    governor.setEnabled(governorParam->get() && ! isNonRealtime());
+    governor.setBudget(cpuBudgetParam->get() * 0.01f);
+    
+    const int tier = governor.update(elapsed, numSamples);
+    
+    if (tier != governorTier)
+    {
+        governorTier = tier;
+        telemetry.governorTierChanges.fetch_add(1, std::memory_order_relaxed);
+    }
+    telemetry.governorTier.store(tier, std::memory_order_relaxed);
+    telemetry.governorLoad.store(governor.getLoad(), std::memory_order_relaxed);
 }
 
 //==============================================================================
@@ -488,6 +1118,34 @@ void EQIsolator4AudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     state.setProperty(LOWMID_BYPASS_ID, lowMidBypassParam->get(), nullptr);
     state.setProperty(MID_BYPASS_ID, midBypassParam->get(), nullptr);
     state.setProperty(HIGH_BYPASS_ID, highBypassParam->get(), nullptr);
+    state.setProperty(MULTIRATE_ID, multirateParam->get(), nullptr);
+    state.setProperty(OFFLINE_HQ_ID, offlineHqParam->get(), nullptr);
+    state.setProperty(GOVERNOR_ID, governorParam->get(), nullptr);
+    state.setProperty(CPU_BUDGET_ID, cpuBudgetParam->get(), nullptr);
+    state.setProperty(LIMITER_MODE_ID, limiterModeParam->getIndex(), nullptr);
+    state.setProperty(LIMITER_CEILING_ID, limiterCeilingParam->get(), nullptr);
+    state.setProperty(LIMITER_LOOKAHEAD_ID, limiterLookaheadParam->get(), nullptr);
+    state.setProperty(LIMITER_RELEASE_ID, limiterReleaseParam->get(), nullptr);
+    
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const auto id = [band](IsolatorCore::Parameter first) { return IsolatorCore::getParameterId((IsolatorCore::Parameter) (first + band)); };
+        state.setProperty(id(IsolatorCore::lowDynamicsMode), dynamicsModeParams[(size_t) band]->getIndex(), nullptr);
+        state.setProperty(id(IsolatorCore::lowThreshold), dynamicsThresholdParams[(size_t) band]->get(), nullptr);
+        state.setProperty(id(IsolatorCore::lowRatio), dynamicsRatioParams[(size_t) band]->get(), nullptr);
+        state.setProperty(id(IsolatorCore::lowAttack), dynamicsAttackParams[(size_t) band]->get(), nullptr);
+        state.setProperty(id(IsolatorCore::lowRelease), dynamicsReleaseParams[(size_t) band]->get(), nullptr);
+    }
+    state.setProperty(IsolatorCore::getParameterId(IsolatorCore::dynamicsRange), dynamicsRangeParam->get(), nullptr);
+    state.setProperty(BYPASS_ID, bypassParam->get(), nullptr);
+    
+    state.setProperty(IsolatorCore::getParameterId(IsolatorCore::stereoMode), stereoModeParam->getIndex(), nullptr);
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const auto id = [band](IsolatorCore::Parameter first) { return IsolatorCore::getParameterId((IsolatorCore::Parameter) (first + band)); };
+        state.setProperty(id(IsolatorCore::lowSideGain), sideGainParams[(size_t) band]->get(), nullptr);
+        state.setProperty(id(IsolatorCore::lowSideBypass), sideBypassParams[(size_t) band]->get(), nullptr);
+    }
     
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
@@ -525,6 +1183,65 @@ void EQIsolator4AudioProcessor::setStateInformation(const void* data, int sizeIn
             
         if (state.hasProperty(HIGH_BYPASS_ID))
             *highBypassParam = static_cast<bool>(state.getProperty(HIGH_BYPASS_ID));
+            
+        if (state.hasProperty(MULTIRATE_ID))
+            *multirateParam = static_cast<bool>(state.getProperty(MULTIRATE_ID));
+            
+        if (state.hasProperty(OFFLINE_HQ_ID))
+            *offlineHqParam = static_cast<bool>(state.getProperty(OFFLINE_HQ_ID));
+            
+        // Sessions saved before the governor existed keep rendering at full quality
+        *governorParam = state.hasProperty(GOVERNOR_ID) && static_cast<bool>(state.getProperty(GOVERNOR_ID));
+            
+        if (state.hasProperty(CPU_BUDGET_ID))
+            *cpuBudgetParam = static_cast<float>(state.getProperty(CPU_BUDGET_ID));
+            
+        if (state.hasProperty(LIMITER_MODE_ID))
+            *limiterModeParam = static_cast<int>(state.getProperty(LIMITER_MODE_ID));
+            
+        if (state.hasProperty(LIMITER_CEILING_ID))
+            *limiterCeilingParam = static_cast<float>(state.getProperty(LIMITER_CEILING_ID));
+            
+        if (state.hasProperty(LIMITER_LOOKAHEAD_ID))
+            *limiterLookaheadParam = static_cast<float>(state.getProperty(LIMITER_LOOKAHEAD_ID));
+            
+        if (state.hasProperty(LIMITER_RELEASE_ID))
+            *limiterReleaseParam = static_cast<float>(state.getProperty(LIMITER_RELEASE_ID));
+            
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            const auto id = [band](IsolatorCore::Parameter first) { return juce::Identifier(IsolatorCore::getParameterId((IsolatorCore::Parameter) (first + band))); };
+            
+            if (state.hasProperty(id(IsolatorCore::lowDynamicsMode)))
+                *dynamicsModeParams[(size_t) band] = static_cast<int>(state.getProperty(id(IsolatorCore::lowDynamicsMode)));
+            if (state.hasProperty(id(IsolatorCore::lowThreshold)))
+                *dynamicsThresholdParams[(size_t) band] = static_cast<float>(state.getProperty(id(IsolatorCore::lowThreshold)));
+            if (state.hasProperty(id(IsolatorCore::lowRatio)))
+                *dynamicsRatioParams[(size_t) band] = static_cast<float>(state.getProperty(id(IsolatorCore::lowRatio)));
+            if (state.hasProperty(id(IsolatorCore::lowAttack)))
+                *dynamicsAttackParams[(size_t) band] = static_cast<float>(state.getProperty(id(IsolatorCore::lowAttack)));
+            if (state.hasProperty(id(IsolatorCore::lowRelease)))
+                *dynamicsReleaseParams[(size_t) band] = static_cast<float>(state.getProperty(id(IsolatorCore::lowRelease)));
+        }
+        
+        if (state.hasProperty(IsolatorCore::getParameterId(IsolatorCore::dynamicsRange)))
+            *dynamicsRangeParam = static_cast<float>(state.getProperty(IsolatorCore::getParameterId(IsolatorCore::dynamicsRange)));
+            
+        if (state.hasProperty(BYPASS_ID))
+            *bypassParam = static_cast<bool>(state.getProperty(BYPASS_ID));
+            
+        if (state.hasProperty(IsolatorCore::getParameterId(IsolatorCore::stereoMode)))
+            *stereoModeParam = static_cast<int>(state.getProperty(IsolatorCore::getParameterId(IsolatorCore::stereoMode)));
+            
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            const auto id = [band](IsolatorCore::Parameter first) { return juce::Identifier(IsolatorCore::getParameterId((IsolatorCore::Parameter) (first + band))); };
+            
+            if (state.hasProperty(id(IsolatorCore::lowSideGain)))
+                *sideGainParams[(size_t) band] = static_cast<float>(state.getProperty(id(IsolatorCore::lowSideGain)));
+            if (state.hasProperty(id(IsolatorCore::lowSideBypass)))
+                *sideBypassParams[(size_t) band] = static_cast<bool>(state.getProperty(id(IsolatorCore::lowSideBypass)));
+        }
     }
 }
 
@@ -538,190 +1255,6 @@ bool EQIsolator4AudioProcessor::getLowMidBypass() const { return lowMidBypassPar
 bool EQIsolator4AudioProcessor::getMidBypass() const { return midBypassParam->get(); }
 bool EQIsolator4AudioProcessor::getHighBypass() const { return highBypassParam->get(); }
 
-//==============================================================================
-// Performance helpers
-//==============================================================================
-
-inline void EQIsolator4AudioProcessor::updateCachedParameters() const noexcept
-{
-    const float lowGain = lowGainParam->get();
-    const float lowMidGain = lowMidGainParam->get();
-    const float midGain = midGainParam->get();
-    const float highGain = highGainParam->get();
-    
-    // Only update if values actually changed (branch prediction friendly)
-    if (lowGain != lastLowGain) {
-        lastLowGain = lowGain;
-        cachedLowGainLinear.store(juce::Decibels::decibelsToGain(lowGain), std::memory_order_relaxed);
-    }
-    if (lowMidGain != lastLowMidGain) {
-        lastLowMidGain = lowMidGain;
-        cachedLowMidGainLinear.store(juce::Decibels::decibelsToGain(lowMidGain), std::memory_order_relaxed);
-    }
-    if (midGain != lastMidGain) {
-        lastMidGain = midGain;
-        cachedMidGainLinear.store(juce::Decibels::decibelsToGain(midGain), std::memory_order_relaxed);
-    }
-    if (highGain != lastHighGain) {
-        lastHighGain = highGain;
-        cachedHighGainLinear.store(juce::Decibels::decibelsToGain(highGain), std::memory_order_relaxed);
-    }
-    
-    // Check bypass changes
-    const bool lowBypass = lowBypassParam->get();
-    const bool lowMidBypass = lowMidBypassParam->get();
-    const bool midBypass = midBypassParam->get();
-    const bool highBypass = highBypassParam->get();
-    
-    if (lowBypass != lastLowBypass || lowMidBypass != lastLowMidBypass || 
-        midBypass != lastMidBypass || highBypass != lastHighBypass) {
-        lastLowBypass = lowBypass;
-        lastLowMidBypass = lowMidBypass;
-        lastMidBypass = midBypass;
-        lastHighBypass = highBypass;
-        filtersNeedUpdate.store(true, std::memory_order_relaxed);
-    }
-}
-
-inline bool EQIsolator4AudioProcessor::checkParametersChanged() const noexcept
-{
-    // Parameter change detection
-    return (lowGainParam->get() != lastLowGain ||
-            lowMidGainParam->get() != lastLowMidGain ||
-            midGainParam->get() != lastMidGain ||
-            highGainParam->get() != lastHighGain ||
-            lowBypassParam->get() != lastLowBypass ||
-            lowMidBypassParam->get() != lastLowMidBypass ||
-            midBypassParam->get() != lastMidBypass ||
-            highBypassParam->get() != lastHighBypass);
-}
-
-void EQIsolator4AudioProcessor::mixBandsOptimized(float* const* channelData, 
-                                                 const float* const* lowData,
-                                                 const float* const* lowMidData,
-                                                 const float* const* midData,
-                                                 const float* const* highData,
-                                                 int numChannels, int numSamples) const noexcept
-{
-    // Load cached gain values once
-    const float lowGain = cachedLowGainLinear.load(std::memory_order_relaxed);
-    const float lowMidGain = cachedLowMidGainLinear.load(std::memory_order_relaxed);
-    const float midGain = cachedMidGainLinear.load(std::memory_order_relaxed);
-    const float highGain = cachedHighGainLinear.load(std::memory_order_relaxed);
-    
-    // Vectorized mixing
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        float* const output = channelData[channel];
-        const float* const low = lowData[channel];
-        const float* const lowMid = lowMidData[channel];
-        const float* const mid = midData[channel];
-        const float* const high = highData[channel];
-        
-        // Vectorized loop with manual unrolling for better performance
-        int i = 0;
-        const int vectorizedEnd = numSamples & ~3; // Process 4 samples at a time
-        
-        for (; i < vectorizedEnd; i += 4)
-        {
-            // Unrolled loop
-            output[i + 0] = low[i + 0] * lowGain + lowMid[i + 0] * lowMidGain + 
-                           mid[i + 0] * midGain + high[i + 0] * highGain;
-            output[i + 1] = low[i + 1] * lowGain + lowMid[i + 1] * lowMidGain + 
-                           mid[i + 1] * midGain + high[i + 1] * highGain;
-            output[i + 2] = low[i + 2] * lowGain + lowMid[i + 2] * lowMidGain + 
-                           mid[i + 2] * midGain + high[i + 2] * highGain;
-            output[i + 3] = low[i + 3] * lowGain + lowMid[i + 3] * lowMidGain + 
-                           mid[i + 3] * midGain + high[i + 3] * highGain;
-        }
-        
-        // Handle remaining samples
-        for (; i < numSamples; ++i)
-        {
-            output[i] = low[i] * lowGain + lowMid[i] * lowMidGain + 
-                       mid[i] * midGain + high[i] * highGain;
-        }
-    }
-}
-
-//==============================================================================
-// Smoothed filter updates (not used in processBlock)
-//==============================================================================
-
-void EQIsolator4AudioProcessor::updateFiltersSmooth(int numSamples)
-{
-    // Set target values for smooth interpolation
-    smoothedLowCutoff.setTargetValue(LOW_LOWMID_CROSSOVER_FREQ);
-    smoothedLowMidCutoff.setTargetValue(LOWMID_MID_CROSSOVER_FREQ);
-    smoothedMidCutoff.setTargetValue(MID_HIGH_CROSSOVER_FREQ);
-    
-    const auto sampleRate = processSpec.sampleRate;
-    
-    const int chunkSize = 32;
-    
-    for (int startSample = 0; startSample < numSamples; startSample += chunkSize)
-    {
-        const int samplesToProcess = juce::jmin(chunkSize, numSamples - startSample);
-        juce::ignoreUnused(samplesToProcess);
-        
-        // Get current smoothed frequencies for this block
-        const float currentLowFreq = smoothedLowCutoff.getNextValue();
-        const float currentLowMidFreq = smoothedLowMidCutoff.getNextValue();
-        const float currentMidFreq = smoothedMidCutoff.getNextValue();
-        
-        // Update coefficients only if frequencies changed significantly
-        static float lastLowFreq = 0.0f;
-        static float lastLowMidFreq = 0.0f;
-        static float lastMidFreq = 0.0f;
-        
-    const float lowFreqThreshold = 5.0f;
-    const float midFreqThreshold = 2.0f;
-    const float highFreqThreshold = 1.0f;
-        
-        if (std::abs(currentLowFreq - lastLowFreq) > lowFreqThreshold ||
-            std::abs(currentLowMidFreq - lastLowMidFreq) > midFreqThreshold ||
-            std::abs(currentMidFreq - lastMidFreq) > highFreqThreshold)
-        {
-            // Update filter coefficients with smoothed frequencies
-            auto lowCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, currentLowFreq);
-            auto lowMidHighPassCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, currentLowFreq);
-            auto lowMidLowPassCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, currentLowMidFreq);
-            auto midHighPassCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, currentLowMidFreq);
-            auto midLowPassCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, currentMidFreq);
-            auto highCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, currentMidFreq);
-            
-            // Apply to all filter chains
-            for (auto& chain : lowPassFilters)
-            {
-                chain.get<0>().coefficients = lowCoeffs;
-                chain.get<1>().coefficients = lowCoeffs;
-            }
-            
-            for (auto& chain : lowMidFilters)
-            {
-                chain.get<0>().coefficients = lowMidHighPassCoeffs;
-                chain.get<1>().coefficients = lowMidLowPassCoeffs;
-            }
-            
-            for (auto& chain : midFilters)
-            {
-                chain.get<0>().coefficients = midHighPassCoeffs;
-                chain.get<1>().coefficients = midLowPassCoeffs;
-            }
-            
-            for (auto& chain : highPassFilters)
-            {
-                chain.get<0>().coefficients = highCoeffs;
-                chain.get<1>().coefficients = highCoeffs;
-            }
-            
-            lastLowFreq = currentLowFreq;
-            lastLowMidFreq = currentLowMidFreq;
-            lastMidFreq = currentMidFreq;
-        }
-    }
-}
-
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
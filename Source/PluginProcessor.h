@@ -9,13 +9,23 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include "CpuGovernor.h"
+#include "FlightRecorder.h"
+#include "HighQualityEngine.h"
+#include "HostBypass.h"
+#include "IsolatorCore.h"
+#include "MultirateLowBranch.h"
+#include "PeakLimiter.h"
+#include "ProcessorTelemetry.h"
+#include "StageProfiler.h"
 
 //==============================================================================
 /**
  * EQIsolator4 - 4-band EQ Isolator plugin
  * Audio processor class for the EQIsolator4 VST3 plugin
  */
-class EQIsolator4AudioProcessor : public juce::AudioProcessor
+class EQIsolator4AudioProcessor : public juce::AudioProcessor,
+                                  private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -31,6 +41,10 @@ public:
 #endif
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    // Global bypass exposed to the host, so it drives our crossfade instead of a hard switch
+    juce::AudioProcessorParameter* getBypassParameter() const override { return bypassParam; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -79,6 +93,31 @@ public:
     bool getMidBypass() const;
     bool getHighBypass() const;
 
+    // Performance counters (prepare cost, rebuilds, ...)
+    const ProcessorTelemetry& getTelemetry() const noexcept { return telemetry; }
+
+    // Flight recorder (EQISOLATOR4_FLIGHT_RECORDER=<seconds>): saves the last seconds of
+    // input, parameters and block timing to a capture file; any thread
+    void requestFlightRecorderDump() noexcept { flightRecorder.requestDump(); }
+    std::string getLastFlightCapturePath() const { return flightRecorder.getLastCapturePath(); }
+
+    // Band analysis (BandAnalyzer): RMS, peak and loudness of the split bands per window,
+    // queued for one consumer (editor timer, file writer). Analysis-only skips everything
+    // after the split and passes the input through, delayed by the reported latency as
+    // when bypassed. Both modes measure mid/side bands when the stereo mode is mid/side.
+    // Mode and window: any thread.
+    enum AnalysisMode { analysisOff = 0, analysisOn, analysisOnly };
+    void setAnalysisMode(int mode) noexcept { analysisMode.store(mode, std::memory_order_relaxed); }
+    int getAnalysisMode() const noexcept { return analysisMode.load(std::memory_order_relaxed); }
+    void setAnalysisWindowSeconds(double seconds) noexcept { bandAnalyzer.setWindowSeconds(seconds); }
+    bool popAnalysisFrame(BandAnalyzer::Frame& frame) noexcept { return bandAnalyzer.pop(frame); }
+
+    // Smoothed linear gain (gain * bypass) each band ended the last block on, for display
+    float getDisplayBandGain(int band) const noexcept { return displayBandGains[(size_t) band].load(std::memory_order_relaxed); }
+
+    // The two biquad sections of each band in processing order: Low, Low-Mid, Mid, High
+    static std::array<juce::dsp::IIR::Coefficients<float>::Ptr, 8> makeBandCoefficients(double sampleRate);
+
     //==============================================================================
     // Parameter IDs for 4 bands
     static constexpr const char* LOW_GAIN_ID = "low_gain";
@@ -90,6 +129,29 @@ public:
     static constexpr const char* MID_BYPASS_ID = "mid_bypass";
     static constexpr const char* HIGH_BYPASS_ID = "high_bypass";
 
+    // Multirate processing of the Low / Low-Mid bands
+    static constexpr const char* MULTIRATE_ID = "multirate";
+
+    // High-quality split while the host renders offline
+    static constexpr const char* OFFLINE_HQ_ID = "offline_hq";
+
+    // CPU-load governor
+    static constexpr const char* GOVERNOR_ID = "cpu_governor";
+    static constexpr const char* CPU_BUDGET_ID = "cpu_budget";
+
+    // Global (host) bypass
+    static constexpr const char* BYPASS_ID = "bypass";
+
+    // Look-ahead brickwall limiter
+    static constexpr const char* LIMITER_MODE_ID = "limiter_mode";
+    static constexpr const char* LIMITER_CEILING_ID = "limiter_ceiling";
+    static constexpr const char* LIMITER_LOOKAHEAD_ID = "limiter_lookahead";
+    static constexpr const char* LIMITER_RELEASE_ID = "limiter_release";
+
+    // Limiter mode choices (index of limiterModeParam)
+    enum LimiterMode { limiterOff = 0, limiterOutput, limiterPerBand, limiterPerBandAndOutput };
+    static constexpr float MAX_LIMITER_LOOKAHEAD_MS = 10.0f;
+
     // Filter cutoff frequencies for 4-band EQ
     // Low: 20 Hz – ~200 Hz 
     // Low-Mid: ~200 Hz – ~700-800 Hz
@@ -108,6 +170,28 @@ public:
     juce::AudioParameterBool* lowMidBypassParam;
     juce::AudioParameterBool* midBypassParam;
     juce::AudioParameterBool* highBypassParam;
+    juce::AudioParameterBool* multirateParam;
+    juce::AudioParameterBool* offlineHqParam;
+    juce::AudioParameterBool* governorParam;
+    juce::AudioParameterFloat* cpuBudgetParam;
+    juce::AudioParameterChoice* limiterModeParam;
+    juce::AudioParameterFloat* limiterCeilingParam;
+    juce::AudioParameterFloat* limiterLookaheadParam;
+    juce::AudioParameterFloat* limiterReleaseParam;
+
+    // Per-band dynamics (Low, Low-Mid, Mid, High); IDs and ranges come from IsolatorCore
+    std::array<juce::AudioParameterChoice*, 4> dynamicsModeParams {};
+    std::array<juce::AudioParameterFloat*, 4> dynamicsThresholdParams {};
+    std::array<juce::AudioParameterFloat*, 4> dynamicsRatioParams {};
+    std::array<juce::AudioParameterFloat*, 4> dynamicsAttackParams {};
+    std::array<juce::AudioParameterFloat*, 4> dynamicsReleaseParams {};
+    juce::AudioParameterFloat* dynamicsRangeParam;
+    juce::AudioParameterBool* bypassParam;
+
+    // Mid/side mode: the band gains and bypasses above act on the mid signal, these on the side
+    juce::AudioParameterChoice* stereoModeParam;
+    std::array<juce::AudioParameterFloat*, 4> sideGainParams {};
+    std::array<juce::AudioParameterBool*, 4> sideBypassParams {};
 
 private:
 
@@ -115,103 +199,134 @@ private:
     using Filter = juce::dsp::IIR::Filter<float>;
     using ProcessorChain = juce::dsp::ProcessorChain<Filter, Filter>;
     
-    std::vector<ProcessorChain> lowPassFilters;    // Low band (20Hz - 200Hz)
-    std::vector<ProcessorChain> lowMidFilters;     // Low-Mid band (200Hz - 750Hz)
-    std::vector<ProcessorChain> midFilters;        // Mid band (750Hz - 3kHz)
-    std::vector<ProcessorChain> highPassFilters;   // High band (3kHz - 20kHz)
+    // Split / gain / mix engine shared with the headless core library: bands Low (20Hz - 200Hz),
+    // Low-Mid (200Hz - 750Hz), Mid (750Hz - 3kHz) and High (3kHz - 20kHz), control curves and band buffers
+    IsolatorCore core;
 
     juce::dsp::ProcessSpec processSpec;
 
-    // Persistent temp buffers per band/channel to avoid RT allocations
-    std::vector<juce::AudioBuffer<float>> lowTempBuffers;
-    std::vector<juce::AudioBuffer<float>> lowMidTempBuffers;
-    std::vector<juce::AudioBuffer<float>> midTempBuffers;
-    std::vector<juce::AudioBuffer<float>> highTempBuffers;
-
-    // DC blocker state for low band (per channel)
-    float dcBlockerR = 0.0f; // pole coefficient ~ exp(-2*pi*fc/fs) for fc ~ 5 Hz
-    std::vector<float> dcPrevXLow; // previous input sample per channel
-    std::vector<float> dcPrevYLow; // previous output sample per channel
-
-    // Per-sample control curves (computed once, reused for all channels)
-    std::vector<float> lowGainCurve;
-    std::vector<float> lowMidGainCurve;
-    std::vector<float> midGainCurve;
-    std::vector<float> highGainCurve;
-    std::vector<float> lowBypassCurve;
-    std::vector<float> lowMidBypassCurve;
-    std::vector<float> midBypassCurve;
-    std::vector<float> highBypassCurve;
-
-    // Prepare and update filters based on current parameters
-    void prepareFilters(double sampleRate, int samplesPerBlock, int numChannels);
-    void updateFilters();
-    void updateFiltersSmooth(int numSamples);
-    
-    //==============================================================================
-    // 🚀 ULTRA-OPTIMIZED PERFORMANCE CACHE SYSTEM 🚀
-    //==============================================================================
+    // Spec of the last prepareToPlay, diffed against to avoid needless rebuilds
+    double preparedSampleRate = 0.0;
+    int preparedNumChannels = -1;
+    int preparedBlockSize = 0;
+
+    ProcessorTelemetry telemetry;
+
+   #if EQISOLATOR4_PROFILE_STAGES
+    // Profiling builds: keeps the stage trace writer running while any instance exists
+    StageProfiler::Session profilerSession;
+   #endif
+
+    // Copies the band gain, bypass, dynamics and mid/side parameters into the core
+    void pushCoreParameters() noexcept;
+
+    // Last smoothed band gains, published once per block for the editor
+    std::array<std::atomic<float>, 4> displayBandGains { { 1.0f, 1.0f, 1.0f, 1.0f } };
+
+    // Look-ahead limiters: one per band (after gain) and one on the summed output
+    std::array<PeakLimiter, 4> bandLimiters;
+    PeakLimiter outputLimiter;
+    int limiterLookaheadSamples = 0;
+    int limiterStages = 0; // number of limiters in series (0, 1 or 2) -> latency multiplier
+    int limiterModeActive = -1;
+    float lastLimiterCeilingDb = 1.0f;
+    float lastLimiterReleaseMs = -1.0f;
+
+    // Per-band output buses (indices 1..4) and their alignment delay for the output limiter
+    int numBandBusesEnabled = 0;
+    std::array<juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None>, 4> bandBusDelays;
+
+    // Pushes limiter parameters to the limiters and reports latency when it changes
+    void updateLimiterSettings();
+
+    // Look-ahead: applied to the limiters at prepare only (it resets them and moves the latency)
+    int getRequestedLookaheadSamples() const;
+    void applyLimiterLookahead();
+    void handleAsyncUpdate() override;
+
+    // Multirate low branch: decimated Low/Low-Mid filtering, full-rate bands delayed to match
+    std::vector<MultirateLowBranch> multirateBranches;
+    std::vector<ProcessorChain> lowPassFiltersReduced;
+    std::vector<ProcessorChain> lowMidFiltersReduced;
+    float dcBlockerRReduced = 0.0f;
+    std::vector<float> dcPrevXLowReduced;
+    std::vector<float> dcPrevYLowReduced;
+    int multirateStages = 0;
+    bool multirateActive = false;
+
+    void prepareMultirate(double sampleRate, int samplesPerBlock, int numChannels);
+    void updateMultirateSettings();
+    void processMultirateLowBands(int channel, const float* input, float* lowData, float* lowMidData, int numSamples);
+
+    // Offline render engine (LR8 crossovers in double precision, 2x oversampled)
+    HighQualityEngine highQualityEngine;
+    bool highQualityActive = false;
+
+    // Switches between the live split and the offline engine (the engine is built in
+    // prepareToPlay for offline renders, here only as a fallback)
+    void updateHighQualitySettings();
     
-    // Pre-allocated buffers to avoid dynamic allocation in processBlock()
-    mutable std::vector<juce::AudioBuffer<float>> preallocatedBandBuffers;
+    // Set on a switch between the two, or of the multirate branch: the split taking over is
+    // primed before the next split
+    bool splitNeedsPrime = false;
+    void primeSplit(int numInputChannels);
+
+    // CPU governor: tier chosen from the previous blocks' cost, applied to the next block
+    CpuGovernor governor;
+    int governorTier = CpuGovernor::tierFull;
+
+    void updateGovernor(double elapsedSeconds, int numSamples);
+    juce::int64 primeTicks = 0; // time spent priming in the current block, excluded from the governor
+
+    // Flight recorder: input and parameters before processing, timing at every return
+    FlightRecorder flightRecorder;
+    void recordFlightInput(const juce::AudioBuffer<float>& buffer, int numChannels);
+    void finishBlock(juce::int64 blockStartTicks, int numSamples);
+
+    // Host bypass: crossfade to the dry input, nothing but the input history while fully bypassed
+    HostBypass hostBypass;
+    juce::AudioBuffer<float> bypassDryBuffer;   // dry signal of a crossfading block
+    juce::AudioBuffer<float> bypassPrimeBuffer; // recent input replayed through the chain when bypass ends
+
+    // Sizes the bypass history for the longest latency this spec can report
+    void prepareHostBypass();
+    void renderBypassed(juce::AudioBuffer<float>& buffer, int numInputChannels, int numSamples);
+    static constexpr int maxPrimeBlocks = 4;
+    void primeAfterBypass(int numInputChannels, int numSamples);
+
+    // Clears the state of every processing stage (split, dynamics, limiters, delays)
+    void resetProcessingState();
+    void resetMultirate();
+
+    // Splits into the core's band buffers with whichever split is active (core, multirate
+    // branch plus upper core bands, or offline engine)
+    void splitInput(const float* const* inputs, int numSplitChannels, int numSamples);
+
+    // Everything after the parameter updates: split, analysis (if 'measure'), dynamics, gains,
+    // limiters, band buses, mix
+    void processBands(juce::AudioBuffer<float>& buffer, int numInputChannels, int numSamples, bool measure);
+
+    // Band analysis; the mode is picked up at the start of each block
+    BandAnalyzer bandAnalyzer;
+    juce::AudioBuffer<float> analysisInputBuffer; // mid/side copy of the input for analysis-only
+    std::atomic<int> analysisMode { analysisOff };
+    int analysisModeActive = analysisOff;
+
+    // Mid/side domain of the last block: the multirate branch and the offline engine are
+    // primed in the new domain when it changes (the core converts its own split state)
+    bool midSideWasActive = false;
+
+    // Dual-mono counters in the telemetry, after each core split
+    void countSplit();
+
+    // Sum of limiter look-ahead and split (multirate or offline engine) delay, reported to the host
+    void updateLatency();
+
+    static void applyDcBlocker(float* data, int numSamples, float r, float& prevX, float& prevY) noexcept;
+
     static constexpr int NUM_BANDS = 4;
     static constexpr int MAX_CHANNELS = 8; // Support up to 8 channels
     
-    // Cached linear gain values (updated only when parameters change)
-    mutable std::atomic<float> cachedLowGainLinear{1.0f};
-    mutable std::atomic<float> cachedLowMidGainLinear{1.0f};
-    mutable std::atomic<float> cachedMidGainLinear{1.0f};
-    mutable std::atomic<float> cachedHighGainLinear{1.0f};
-    
-    // 🎵 PARAMETER SMOOTHING - ELIMINATES ALL AUDIO CLICKS 🎵
-    juce::SmoothedValue<float> smoothedLowGain;
-    juce::SmoothedValue<float> smoothedLowMidGain;
-    juce::SmoothedValue<float> smoothedMidGain;
-    juce::SmoothedValue<float> smoothedHighGain;
-    
-    // Filter coefficient smoothing to prevent filter resonance clicks
-    mutable juce::SmoothedValue<float> smoothedLowCutoff;
-    mutable juce::SmoothedValue<float> smoothedLowMidCutoff;
-    mutable juce::SmoothedValue<float> smoothedMidCutoff;
-    
-    // Bypass smoothing to eliminate bypass clicks
-    juce::SmoothedValue<float> smoothedLowBypass;
-    juce::SmoothedValue<float> smoothedLowMidBypass;
-    juce::SmoothedValue<float> smoothedMidBypass;
-    juce::SmoothedValue<float> smoothedHighBypass;
-    
-    // Parameter change flags for smart updates
-    mutable std::atomic<bool> parametersChanged{true};
-    mutable std::atomic<bool> filtersNeedUpdate{true};
-    
-    // Previous parameter values for change detection
-    mutable float lastLowGain = 0.0f;
-    mutable float lastLowMidGain = 0.0f;
-    mutable float lastMidGain = 0.0f;
-    mutable float lastHighGain = 0.0f;
-    mutable bool lastLowBypass = false;
-    mutable bool lastLowMidBypass = false;
-    mutable bool lastMidBypass = false;
-    mutable bool lastHighBypass = false;
-    
-    // Ultra-fast parameter access with caching
-    inline void updateCachedParameters() const noexcept;
-    inline bool checkParametersChanged() const noexcept;
-    
-    // SIMD-optimized mixing function
-    void mixBandsOptimized(float* const* channelData, 
-                          const float* const* lowData,
-                          const float* const* lowMidData, 
-                          const float* const* midData,
-                          const float* const* highData,
-                          int numChannels, int numSamples) const noexcept;
-                          
-    // Memory alignment helpers for SIMD
-    static constexpr size_t SIMD_ALIGNMENT = 16;
-
-    // Low gain target deadband (dB domain) to suppress micro-steps
-    float lastLowGainTargetDb = 0.0f;
-    
     //==============================================================================
     // 💎 CREATOR WATERMARK - PROTECTED & IMMUTABLE 💎
     //==============================================================================
@@ -0,0 +1,37 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <atomic>
+
+//==============================================================================
+/**
+ * Lock-free counters and timings published by the processor.
+ * Written with relaxed stores; any thread (editor, host tooling) may read them.
+ */
+struct ProcessorTelemetry
+{
+    // prepareToPlay cost and what it had to redo
+    std::atomic<double> lastPrepareMs { 0.0 };
+    std::atomic<bool> lastPrepareWasFullRebuild { false };
+    std::atomic<int> prepareCount { 0 };
+    std::atomic<int> filterRebuildCount { 0 };      // channel layout changed
+    std::atomic<int> coefficientUpdateCount { 0 };  // sample rate or layout changed
+    std::atomic<int> bufferReallocationCount { 0 }; // block size grew or layout changed
+
+    // CPU governor (see CpuGovernor::Tier)
+    std::atomic<int> governorTier { 0 };
+    std::atomic<float> governorLoad { 0.0f };     // smoothed block cost / deadline
+    std::atomic<int> governorTierChanges { 0 };
+
+    // Dual-mono detection: blocks whose channels were split once (IsolatorCore::splitBands)
+    std::atomic<int> linkedSplitBlocks { 0 };
+    std::atomic<int> splitBlocks { 0 };
+
+    // Blocks passed through while fully bypassed (global bypass)
+    std::atomic<int> bypassedBlocks { 0 };
+};
@@ -0,0 +1,329 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "ResponseCurveComponent.h"
+
+//==============================================================================
+// Background evaluation of the combined response. H(e^jw) of every biquad is
+// computed with SIMD complex arithmetic across frequency points, the bands are
+// multiplied out, weighted by their gains and summed as complex values (the
+// bands are summed in the time domain, so magnitudes alone would be wrong).
+//==============================================================================
+class ResponseCurveComponent::Worker : public juce::Thread
+{
+public:
+    explicit Worker(ResponseCurveComponent& o)
+        : juce::Thread("EQIsolator4 Response"), owner(o)
+    {
+    }
+
+    void post(const Request& request)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            pending = request;
+            hasPending = true;
+        }
+        notify();
+    }
+
+    bool fetch(Result& destination)
+    {
+        const juce::ScopedLock sl(lock);
+        if (! hasResult)
+            return false;
+
+        std::swap(destination, finished);
+        hasResult = false;
+        return true;
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            Request request;
+            bool haveRequest = false;
+            {
+                const juce::ScopedLock sl(lock);
+                if (hasPending)
+                {
+                    request = pending;
+                    hasPending = false;
+                    haveRequest = true;
+                }
+            }
+
+            if (! haveRequest)
+            {
+                wait(-1);
+                continue;
+            }
+
+            Result result = evaluate(request);
+            {
+                const juce::ScopedLock sl(lock);
+                finished = std::move(result);
+                hasResult = true;
+            }
+            owner.triggerAsyncUpdate();
+        }
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int) Vec::SIMDNumElements;
+    static constexpr int numVecs = numPoints / lanes;
+    static_assert(numPoints % lanes == 0, "numPoints must be a multiple of the SIMD width");
+
+    struct ComplexVec
+    {
+        Vec re, im;
+    };
+
+    // cos/sin of w and 2w at every point (z^-1 = cos w - j sin w); rebuilt per sample rate
+    void updateGrid(double sampleRate)
+    {
+        if (sampleRate == gridSampleRate)
+            return;
+
+        gridSampleRate = sampleRate;
+        cos1.resize(numVecs); sin1.resize(numVecs);
+        cos2.resize(numVecs); sin2.resize(numVecs);
+
+        for (int p = 0; p < numPoints; ++p)
+        {
+            const double proportion = (double) p / (double) (numPoints - 1);
+            const double frequency = minFrequency * std::pow((double) maxFrequency / minFrequency, proportion);
+            const double w = juce::jmin(juce::MathConstants<double>::twoPi * frequency / sampleRate,
+                                        juce::MathConstants<double>::pi);
+
+            const size_t v = (size_t) (p / lanes), lane = (size_t) (p % lanes);
+            cos1[v].set(lane, (float) std::cos(w));
+            sin1[v].set(lane, (float) std::sin(w));
+            cos2[v].set(lane, (float) std::cos(2.0 * w));
+            sin2[v].set(lane, (float) std::sin(2.0 * w));
+        }
+    }
+
+    // H(e^jw) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2) for one vector of points
+    ComplexVec evaluateSection(const float* c, size_t v) const noexcept
+    {
+        const Vec zero = Vec::expand(0.0f);
+        const Vec b0 = Vec::expand(c[0]), b1 = Vec::expand(c[1]), b2 = Vec::expand(c[2]);
+        const Vec a1 = Vec::expand(c[3]), a2 = Vec::expand(c[4]);
+
+        const Vec numRe = b0 + b1 * cos1[v] + b2 * cos2[v];
+        const Vec numIm = zero - (b1 * sin1[v] + b2 * sin2[v]);
+        const Vec denRe = Vec::expand(1.0f) + a1 * cos1[v] + a2 * cos2[v];
+        const Vec denIm = zero - (a1 * sin1[v] + a2 * sin2[v]);
+
+        Vec invMagSq = denRe * denRe + denIm * denIm;
+        for (size_t lane = 0; lane < (size_t) lanes; ++lane)
+            invMagSq.set(lane, 1.0f / juce::jmax(invMagSq.get(lane), 1.0e-30f));
+
+        return { (numRe * denRe + numIm * denIm) * invMagSq,
+                 (numIm * denRe - numRe * denIm) * invMagSq };
+    }
+
+    static ComplexVec multiply(const ComplexVec& x, const ComplexVec& y) noexcept
+    {
+        return { x.re * y.re - x.im * y.im, x.re * y.im + x.im * y.re };
+    }
+
+    Result evaluate(const Request& request)
+    {
+        updateGrid(request.sampleRate);
+
+        const auto sections = EQIsolator4AudioProcessor::makeBandCoefficients(request.sampleRate);
+
+        std::array<float, numPoints> magnitudeDb {}, phase {};
+
+        for (size_t v = 0; v < (size_t) numVecs; ++v)
+        {
+            ComplexVec total { Vec::expand(0.0f), Vec::expand(0.0f) };
+
+            for (size_t band = 0; band < 4; ++band)
+            {
+                const auto h = multiply(evaluateSection(sections[band * 2]->getRawCoefficients(), v),
+                                        evaluateSection(sections[band * 2 + 1]->getRawCoefficients(), v));
+                const float gain = request.bandGains[band];
+                total.re = total.re + h.re * gain;
+                total.im = total.im + h.im * gain;
+            }
+
+            for (size_t lane = 0; lane < (size_t) lanes; ++lane)
+            {
+                const float re = total.re.get(lane), im = total.im.get(lane);
+                const size_t p = v * (size_t) lanes + lane;
+                magnitudeDb[p] = 10.0f * std::log10(juce::jmax(re * re + im * im, 1.0e-12f));
+                phase[p] = std::atan2(im, re);
+            }
+        }
+
+        Result result;
+        const float width = (float) request.width, height = (float) request.height;
+
+        for (int p = 0; p < numPoints; ++p)
+        {
+            const float x = width * (float) p / (float) (numPoints - 1);
+            const float magY = juce::jmap(juce::jlimit(minDecibels, maxDecibels, magnitudeDb[(size_t) p]),
+                                          minDecibels, maxDecibels, height, 0.0f);
+            const float phaseY = juce::jmap(phase[(size_t) p], -juce::MathConstants<float>::pi,
+                                            juce::MathConstants<float>::pi, height, 0.0f);
+
+            if (p == 0)
+                result.magnitude.startNewSubPath(x, magY);
+            else
+                result.magnitude.lineTo(x, magY);
+
+            // Don't draw the vertical jump where the phase wraps
+            if (p == 0 || std::abs(phase[(size_t) p] - phase[(size_t) p - 1]) > juce::MathConstants<float>::pi)
+                result.phase.startNewSubPath(x, phaseY);
+            else
+                result.phase.lineTo(x, phaseY);
+        }
+
+        return result;
+    }
+
+    ResponseCurveComponent& owner;
+    juce::CriticalSection lock;
+    Request pending;
+    Result finished;
+    bool hasPending = false, hasResult = false;
+
+    double gridSampleRate = 0.0;
+    std::vector<Vec> cos1, sin1, cos2, sin2;
+};
+
+//==============================================================================
+bool ResponseCurveComponent::Request::differsFrom(const Request& other) const noexcept
+{
+    if (sampleRate != other.sampleRate || width != other.width || height != other.height)
+        return true;
+
+    // ~0.01 dB tolerance so settled smoothers don't trigger re-evaluation
+    for (size_t band = 0; band < bandGains.size(); ++band)
+    {
+        const float a = bandGains[band], b = other.bandGains[band];
+        if (std::abs(a - b) > 0.00115f * juce::jmax(a, b) + 1.0e-7f)
+            return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+ResponseCurveComponent::ResponseCurveComponent(EQIsolator4AudioProcessor& p)
+    : audioProcessor(p), worker(std::make_unique<Worker>(*this))
+{
+    setOpaque(true);
+    worker->startThread();
+}
+
+ResponseCurveComponent::~ResponseCurveComponent()
+{
+    worker->signalThreadShouldExit();
+    worker->notify();
+    worker->stopThread(2000);
+    cancelPendingUpdate();
+}
+
+ResponseCurveComponent::Request ResponseCurveComponent::makeRequest() const
+{
+    Request request;
+    request.sampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : 44100.0;
+    for (int band = 0; band < 4; ++band)
+        request.bandGains[(size_t) band] = audioProcessor.getDisplayBandGain(band);
+    request.width = getWidth();
+    request.height = getHeight();
+    return request;
+}
+
+void ResponseCurveComponent::refresh()
+{
+    // Cheap poll of atomics; the worker only runs when something actually changed
+    const auto request = makeRequest();
+    if (request.width <= 0 || request.height <= 0 || ! request.differsFrom(lastRequest))
+        return;
+
+    lastRequest = request;
+    worker->post(request);
+}
+
+void ResponseCurveComponent::handleAsyncUpdate()
+{
+    if (worker->fetch(current))
+        repaint();
+}
+
+//==============================================================================
+void ResponseCurveComponent::paint(juce::Graphics& g)
+{
+    const PaintStats::ScopedMeasurement measurement(paintStats);
+
+    // Static layers are re-rendered only on resize or a display scale change
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! gridImage.isValid() || scale != gridScale)
+        renderGrid(scale);
+
+    g.drawImage(gridImage, getLocalBounds().toFloat());
+
+    g.setColour(juce::Colours::lightblue.withAlpha(0.35f));
+    g.strokePath(current.phase, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(current.magnitude, juce::PathStrokeType(1.5f));
+}
+
+void ResponseCurveComponent::renderGrid(float scale)
+{
+    gridScale = scale;
+    gridImage = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt((float) getWidth() * scale)),
+                            juce::jmax(1, juce::roundToInt((float) getHeight() * scale)), false);
+
+    juce::Graphics g(gridImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    const auto bounds = getLocalBounds().toFloat();
+    g.fillAll(juce::Colour(0xff121416));
+
+    auto xForFrequency = [&bounds](float frequency)
+    {
+        return bounds.getWidth() * std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+    };
+    auto yForDecibels = [&bounds](float decibels)
+    {
+        return juce::jmap(decibels, minDecibels, maxDecibels, bounds.getHeight(), 0.0f);
+    };
+
+    // Grid: decades and 12 dB steps
+    g.setColour(juce::Colours::grey.withAlpha(0.25f));
+    for (float frequency : { 100.0f, 1000.0f, 10000.0f })
+        g.drawVerticalLine(juce::roundToInt(xForFrequency(frequency)), 0.0f, bounds.getHeight());
+    for (float decibels = minDecibels + 12.0f; decibels < maxDecibels; decibels += 12.0f)
+        g.drawHorizontalLine(juce::roundToInt(yForDecibels(decibels)), 0.0f, bounds.getWidth());
+
+    g.setColour(juce::Colours::grey.withAlpha(0.6f));
+    g.drawHorizontalLine(juce::roundToInt(yForDecibels(0.0f)), 0.0f, bounds.getWidth());
+
+    // Crossover markers
+    g.setColour(juce::Colours::orange.withAlpha(0.35f));
+    for (float frequency : { EQIsolator4AudioProcessor::LOW_LOWMID_CROSSOVER_FREQ,
+                             EQIsolator4AudioProcessor::LOWMID_MID_CROSSOVER_FREQ,
+                             EQIsolator4AudioProcessor::MID_HIGH_CROSSOVER_FREQ })
+        g.drawVerticalLine(juce::roundToInt(xForFrequency(frequency)), 0.0f, bounds.getHeight());
+
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds());
+}
+
+void ResponseCurveComponent::resized()
+{
+    // The size is part of the request, so the next refresh rebuilds the paths
+    gridImage = {};
+}
@@ -0,0 +1,83 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "PluginProcessor.h"
+#include "PaintStats.h"
+
+//==============================================================================
+/**
+ * Combined magnitude/phase response of the band split as it is currently heard
+ * (filter coefficients + smoothed band gains).
+ *
+ * The response is evaluated on a background thread, only when the gains or the
+ * sample rate change, and handed back as ready-made paths. The audio thread is
+ * never touched: the processor just publishes its smoothed gains once per block.
+ *
+ * There is no timer: the editor calls refresh() from its vblank callback while
+ * it is showing. The grid is cached in an image; only the curves are stroked per paint.
+ */
+class ResponseCurveComponent : public juce::Component,
+                               private juce::AsyncUpdater
+{
+public:
+    explicit ResponseCurveComponent(EQIsolator4AudioProcessor&);
+    ~ResponseCurveComponent() override;
+
+    //==============================================================================
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+    /** Polls the processor's display gains and requests a new evaluation if they moved. */
+    void refresh();
+
+    const PaintStats& getPaintStats() const noexcept { return paintStats; }
+    PaintStats& getPaintStats() noexcept { return paintStats; }
+
+    static constexpr int numPoints = 256;          // log-spaced evaluation points
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float minDecibels = -48.0f;
+    static constexpr float maxDecibels = 24.0f;
+
+private:
+    // Everything the curve depends on; a new evaluation is requested when this changes
+    struct Request
+    {
+        double sampleRate = 0.0;
+        std::array<float, 4> bandGains {};
+        int width = 0, height = 0;
+
+        bool differsFrom(const Request& other) const noexcept;
+    };
+
+    struct Result
+    {
+        juce::Path magnitude, phase;
+    };
+
+    class Worker;
+
+    void handleAsyncUpdate() override;
+    Request makeRequest() const;
+    void renderGrid(float scale);
+
+    EQIsolator4AudioProcessor& audioProcessor;
+    std::unique_ptr<Worker> worker;
+
+    Request lastRequest;
+    Result current;
+
+    // Grid, 0 dB line, crossover markers and border at the display's pixel scale
+    juce::Image gridImage;
+    float gridScale = 0.0f;
+
+    PaintStats paintStats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurveComponent)
+};
@@ -0,0 +1,282 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#include "StageProfiler.h"
+
+#if EQISOLATOR4_PROFILE_STAGES
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace StageProfiler
+{
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        std::uint64_t begin, end;
+    };
+
+    //==============================================================================
+    // One producer (the owning thread), one consumer (the writer)
+    struct Ring
+    {
+        static constexpr std::uint32_t capacity = 1u << 13; // power of two
+
+        enum State { slotFree = 0, slotOwned, slotRetired };
+        std::atomic<int> state { slotFree };
+
+        std::atomic<std::uint32_t> written { 0 }, read { 0 };
+        std::atomic<std::uint32_t> dropped { 0 };
+        Event events[capacity];
+    };
+
+    // Fixed pool: a thread claims a ring on its first marker and gives it back on exit
+    constexpr int maxThreads = 64;
+    Ring rings[maxThreads];
+    std::atomic<std::uint32_t> unclaimedDrops { 0 }; // threads that found no free ring
+
+    struct ThreadSlot
+    {
+        Ring* ring = nullptr;
+        bool claimed = false;
+
+        Ring* get() noexcept
+        {
+            if (! claimed)
+            {
+                claimed = true;
+                for (auto& candidate : rings)
+                {
+                    int expected = Ring::slotFree;
+                    if (candidate.state.compare_exchange_strong(expected, Ring::slotOwned, std::memory_order_acq_rel))
+                    {
+                        ring = &candidate;
+                        break;
+                    }
+                }
+            }
+            return ring;
+        }
+
+        // The writer drains what is left, then frees the ring
+        ~ThreadSlot()
+        {
+            if (ring != nullptr)
+                ring->state.store(Ring::slotRetired, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadSlot threadSlot;
+
+    //==============================================================================
+    class Writer
+    {
+    public:
+        void start()
+        {
+            const char* configured = std::getenv("EQISOLATOR4_TRACE_FILE");
+            std::string path;
+            if (configured != nullptr && *configured != 0)
+            {
+                path = configured;
+            }
+            else
+            {
+                std::error_code error;
+                const auto folder = std::filesystem::temp_directory_path(error);
+                const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                path = (folder / ("EQIsolator4-trace-" + std::to_string(stamp) + ".json")).string();
+            }
+
+            file = std::fopen(path.c_str(), "w");
+            if (file == nullptr)
+                return;
+
+            // JSON array form: still loads if the host dies before the closing bracket
+            std::fputs("[\n", file);
+            firstEvent = true;
+
+            // Earlier events are discarded, so the trace starts with the session
+            for (auto& ring : rings)
+            {
+                ring.read.store(ring.written.load(std::memory_order_acquire), std::memory_order_release);
+                ring.dropped.store(0, std::memory_order_relaxed);
+            }
+
+            startTicks = now();
+            startTime = std::chrono::steady_clock::now();
+            ticksPerMicrosecond = 0.0;
+
+            stopRequested = false;
+            thread = std::thread([this] { run(); });
+        }
+
+        void stop()
+        {
+            if (! thread.joinable())
+                return;
+
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                stopRequested = true;
+            }
+            wakeUp.notify_one();
+            thread.join();
+
+            drain();
+            writeDropCounts();
+            std::fputs("\n]\n", file);
+            std::fclose(file);
+            file = nullptr;
+        }
+
+    private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (! stopRequested)
+            {
+                wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+
+        // Cycle counter rate measured over the whole session so far
+        void calibrate() noexcept
+        {
+            const double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+            if (elapsedUs > 1000.0)
+                ticksPerMicrosecond = (double) (now() - startTicks) / elapsedUs;
+        }
+
+        void drain()
+        {
+            calibrate();
+            if (ticksPerMicrosecond <= 0.0)
+                return;
+
+            for (int index = 0; index < maxThreads; ++index)
+            {
+                auto& ring = rings[index];
+                const int state = ring.state.load(std::memory_order_acquire);
+                if (state == Ring::slotFree)
+                    continue;
+
+                const std::uint32_t end = ring.written.load(std::memory_order_acquire);
+                std::uint32_t position = ring.read.load(std::memory_order_relaxed);
+
+                for (; position != end; ++position)
+                {
+                    const Event& event = ring.events[position & (Ring::capacity - 1)];
+                    if (event.begin < startTicks)
+                        continue;
+
+                    std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                                 firstEvent ? "" : ",\n", event.name, index + 1,
+                                 (double) (event.begin - startTicks) / ticksPerMicrosecond,
+                                 (double) (event.end - event.begin) / ticksPerMicrosecond);
+                    firstEvent = false;
+                }
+                ring.read.store(position, std::memory_order_release);
+
+                if (state == Ring::slotRetired)
+                {
+                    writeDropCount(index + 1, ring.dropped.exchange(0, std::memory_order_relaxed));
+                    ring.state.store(Ring::slotFree, std::memory_order_release);
+                }
+            }
+
+            std::fflush(file);
+        }
+
+        void writeDropCounts()
+        {
+            for (int index = 0; index < maxThreads; ++index)
+                writeDropCount(index + 1, rings[index].dropped.exchange(0, std::memory_order_relaxed));
+
+            // Threads that found every ring taken
+            writeDropCount(0, unclaimedDrops.exchange(0, std::memory_order_relaxed));
+        }
+
+        // Shown as a counter track when a ring overflowed (drain interval too long for the load);
+        // thread id 0 stands for threads that got no ring
+        void writeDropCount(int threadId, std::uint32_t count)
+        {
+            if (count > 0)
+            {
+                std::fprintf(file, "%s{\"name\":\"dropped events\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":0,\"args\":{\"dropped\":%u}}",
+                             firstEvent ? "" : ",\n", threadId, (unsigned int) count);
+                firstEvent = false;
+            }
+        }
+
+        std::FILE* file = nullptr;
+        bool firstEvent = true;
+
+        std::uint64_t startTicks = 0;
+        std::chrono::steady_clock::time_point startTime;
+        double ticksPerMicrosecond = 0.0;
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        bool stopRequested = false;
+    };
+
+    std::mutex sessionLock;
+    int numSessions = 0;
+    Writer writer;
+}
+
+//==============================================================================
+void record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+{
+    Ring* ring = threadSlot.get();
+    if (ring == nullptr)
+    {
+        unclaimedDrops.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const std::uint32_t position = ring->written.load(std::memory_order_relaxed);
+    if (position - ring->read.load(std::memory_order_acquire) >= Ring::capacity)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[position & (Ring::capacity - 1)] = { name, begin, end };
+    ring->written.store(position + 1, std::memory_order_release);
+}
+
+Session::Session()
+{
+    const std::lock_guard<std::mutex> lock(sessionLock);
+    if (numSessions++ == 0)
+        writer.start();
+}
+
+Session::~Session()
+{
+    const std::lock_guard<std::mutex> lock(sessionLock);
+    if (--numSessions == 0)
+        writer.stop();
+}
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+ * Per-stage profiling, compiled in only with EQISOLATOR4_PROFILE_STAGES=1
+ * (CMake option of the same name). Otherwise EQ4_PROFILE_SCOPE expands to
+ * nothing and this header declares nothing else.
+ *
+ * EQ4_PROFILE_SCOPE("name") times the rest of the enclosing scope with the
+ * CPU cycle counter. Names must be string literals (only the pointer is kept).
+ * Each thread records into its own fixed ring (claimed once, no locks, no
+ * allocation); a full ring drops events and counts them. A Session, held by
+ * every processor in a profiling build, runs one writer thread per process
+ * that drains the rings every 100 ms into a Chrome / Perfetto trace file:
+ * EQISOLATOR4_TRACE_FILE if set, else EQIsolator4-trace-<time>.json in the
+ * temp directory. Open it in chrome://tracing or ui.perfetto.dev; thread
+ * ids are ring slots, not OS thread ids.
+ */
+
+#if EQISOLATOR4_PROFILE_STAGES
+
+#include <cstdint>
+
+#if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+ #include <intrin.h>
+#elif defined (__x86_64__) || defined (__i386__)
+ #include <x86intrin.h>
+#else
+ #include <chrono>
+#endif
+
+namespace StageProfiler
+{
+    /** Raw cycle counter (TSC / virtual counter), converted to time when written out. */
+    inline std::uint64_t now() noexcept
+    {
+       #if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+        return __rdtsc();
+       #elif defined (__x86_64__) || defined (__i386__)
+        return __rdtsc();
+       #elif defined (__aarch64__)
+        std::uint64_t ticks;
+        asm volatile ("mrs %0, cntvct_el0" : "=r" (ticks));
+        return ticks;
+       #else
+        return (std::uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+       #endif
+    }
+
+    /** Appends one event to the calling thread's ring; wait-free. */
+    void record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+    struct Scope
+    {
+        explicit Scope(const char* stageName) noexcept : name(stageName), begin(now()) {}
+        ~Scope() { record(name, begin, now()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        const char* const name;
+        const std::uint64_t begin;
+    };
+
+    /** Keeps the trace writer running; the first one opens the file, the last one closes it. */
+    class Session
+    {
+    public:
+        Session();
+        ~Session();
+
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+    };
+}
+
+#define EQ4_PROFILE_JOIN_(a, b) a##b
+#define EQ4_PROFILE_JOIN(a, b) EQ4_PROFILE_JOIN_(a, b)
+#define EQ4_PROFILE_SCOPE(name) const StageProfiler::Scope EQ4_PROFILE_JOIN(stageProfilerScope, __LINE__) (name)
+
+#else
+
+#define EQ4_PROFILE_SCOPE(name) ((void) 0)
+
+#endif
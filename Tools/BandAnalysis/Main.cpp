@@ -0,0 +1,309 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Per-band level report of a WAV file, on the JUCE-free core (EQIsolator4Core).
+//
+// Runs the isolator's split in analysis-only mode (no dynamics, no mix) and
+// writes one CSV row per window: start and length in seconds, then RMS (dBFS),
+// sample peak (dBFS) and K-weighted loudness (LUFS) of Low, Low-Mid, Mid and
+// High. A summary per band over the whole file and the speed against real time
+// go to stderr (stdout if the CSV goes to a file).
+//
+// Reads PCM 16/24/32-bit and 32-bit float WAV (up to 8 channels), streamed.
+//
+// Usage: EQIsolator4BandAnalysis <input.wav> [--window SECONDS] [--block B] [--output out.csv]
+
+#include "IsolatorCore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const char* stringArg(int argc, char** argv, const char* name, const char* fallback)
+    {
+        for (int i = 1; i + 1 < argc; ++i)
+            if (std::strcmp(argv[i], name) == 0)
+                return argv[i + 1];
+        return fallback;
+    }
+
+    double numberArg(int argc, char** argv, const char* name, double fallback)
+    {
+        const char* value = stringArg(argc, argv, name, nullptr);
+        return value != nullptr ? std::atof(value) : fallback;
+    }
+
+    struct FileCloser
+    {
+        void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+    };
+
+    //==============================================================================
+    // Minimal streaming WAV reader: RIFF chunks up to "data", then frames on demand
+    class WavReader
+    {
+    public:
+        int numChannels = 0;
+        int bitsPerSample = 0;
+        bool isFloat = false;
+        double sampleRate = 0.0;
+        std::uint64_t numFrames = 0;
+
+        bool open(const char* path)
+        {
+            file.reset(std::fopen(path, "rb"));
+            if (file == nullptr)
+                return false;
+
+            char riff[12];
+            if (std::fread(riff, 1, sizeof(riff), file.get()) != sizeof(riff)
+                || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0)
+                return false;
+
+            bool haveFormat = false;
+            for (;;)
+            {
+                char id[4];
+                std::uint32_t size = 0;
+                if (std::fread(id, 1, 4, file.get()) != 4 || ! readLittleEndian(size))
+                    return false;
+
+                if (std::memcmp(id, "fmt ", 4) == 0)
+                {
+                    std::uint8_t format[40] = {};
+                    const std::uint32_t toRead = size < sizeof(format) ? size : (std::uint32_t) sizeof(format);
+                    if (size < 16 || std::fread(format, 1, toRead, file.get()) != toRead
+                        || ! skip((long) (size - toRead) + (long) (size & 1)))
+                        return false;
+
+                    std::uint16_t tag = (std::uint16_t) (format[0] | format[1] << 8);
+                    numChannels = format[2] | format[3] << 8;
+                    sampleRate = (double) ((std::uint32_t) format[4] | (std::uint32_t) format[5] << 8
+                                           | (std::uint32_t) format[6] << 16 | (std::uint32_t) format[7] << 24);
+                    bitsPerSample = format[14] | format[15] << 8;
+
+                    // WAVE_FORMAT_EXTENSIBLE: the real tag leads the sub-format GUID
+                    if (tag == 0xfffe && toRead >= 26)
+                        tag = (std::uint16_t) (format[24] | format[25] << 8);
+
+                    isFloat = (tag == 3);
+                    haveFormat = (tag == 1 && (bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32))
+                              || (tag == 3 && bitsPerSample == 32);
+                }
+                else if (std::memcmp(id, "data", 4) == 0)
+                {
+                    if (! haveFormat || numChannels <= 0 || numChannels > IsolatorCore::maxChannels || sampleRate <= 0.0)
+                        return false;
+
+                    numFrames = size / (std::uint64_t) (numChannels * (bitsPerSample / 8));
+                    return true;
+                }
+                else if (! skip((long) size + (long) (size & 1)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        /** Reads up to numFramesWanted frames into planar channels; returns the number read. */
+        int read(std::vector<std::vector<float>>& channels, int numFramesWanted)
+        {
+            const int bytesPerSample = bitsPerSample / 8;
+            const std::uint64_t remaining = numFrames - position;
+            const int n = (int) (remaining < (std::uint64_t) numFramesWanted ? remaining : (std::uint64_t) numFramesWanted);
+
+            raw.resize((size_t) (n * numChannels * bytesPerSample));
+            const size_t got = std::fread(raw.data(), (size_t) (numChannels * bytesPerSample), (size_t) n, file.get());
+
+            for (size_t frame = 0; frame < got; ++frame)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const std::uint8_t* bytes = raw.data() + (frame * (size_t) numChannels + (size_t) channel) * (size_t) bytesPerSample;
+                    channels[(size_t) channel][frame] = decode(bytes);
+                }
+            }
+
+            position += got;
+            return (int) got;
+        }
+
+    private:
+        bool readLittleEndian(std::uint32_t& value)
+        {
+            std::uint8_t bytes[4];
+            if (std::fread(bytes, 1, 4, file.get()) != 4)
+                return false;
+            value = (std::uint32_t) bytes[0] | (std::uint32_t) bytes[1] << 8 | (std::uint32_t) bytes[2] << 16 | (std::uint32_t) bytes[3] << 24;
+            return true;
+        }
+
+        bool skip(long bytes)
+        {
+            return bytes == 0 || std::fseek(file.get(), bytes, SEEK_CUR) == 0;
+        }
+
+        float decode(const std::uint8_t* bytes) const noexcept
+        {
+            if (isFloat)
+            {
+                const std::uint32_t bits = (std::uint32_t) bytes[0] | (std::uint32_t) bytes[1] << 8
+                                         | (std::uint32_t) bytes[2] << 16 | (std::uint32_t) bytes[3] << 24;
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            switch (bitsPerSample)
+            {
+                case 16: return (float) (std::int16_t) (bytes[0] | bytes[1] << 8) / 32768.0f;
+                case 24: return (float) ((std::int32_t) ((std::uint32_t) bytes[0] << 8 | (std::uint32_t) bytes[1] << 16
+                                                         | (std::uint32_t) bytes[2] << 24) >> 8) / 8388608.0f;
+                default: return (float) ((double) (std::int32_t) ((std::uint32_t) bytes[0] | (std::uint32_t) bytes[1] << 8
+                                                                   | (std::uint32_t) bytes[2] << 16 | (std::uint32_t) bytes[3] << 24)
+                                         / 2147483648.0);
+            }
+        }
+
+        std::unique_ptr<std::FILE, FileCloser> file;
+        std::vector<std::uint8_t> raw;
+        std::uint64_t position = 0;
+    };
+
+    // Whole-file figures per band, accumulated from the frames
+    struct Summary
+    {
+        double power[BandAnalyzer::numBands] {};
+        double weightedPower[BandAnalyzer::numBands] {};
+        float peakDb[BandAnalyzer::numBands] { BandAnalyzer::floorDecibels, BandAnalyzer::floorDecibels,
+                                               BandAnalyzer::floorDecibels, BandAnalyzer::floorDecibels };
+        std::uint64_t numSamples = 0;
+        int numFrames = 0;
+
+        void add(const BandAnalyzer::Frame& frame)
+        {
+            for (int band = 0; band < BandAnalyzer::numBands; ++band)
+            {
+                power[band] += std::pow(10.0, frame.rmsDb[band] / 10.0) * frame.numSamples;
+                weightedPower[band] += std::pow(10.0, (frame.loudnessLufs[band] + 0.691) / 10.0) * frame.numSamples;
+                peakDb[band] = frame.peakDb[band] > peakDb[band] ? frame.peakDb[band] : peakDb[band];
+            }
+            numSamples += frame.numSamples;
+            ++numFrames;
+        }
+    };
+
+    const char* const bandNames[BandAnalyzer::numBands] = { "low", "lowmid", "mid", "high" };
+}
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argv[1][0] == '-')
+    {
+        std::fprintf(stderr, "Usage: EQIsolator4BandAnalysis <input.wav> [--window SECONDS] [--block B] [--output out.csv]\n");
+        return 2;
+    }
+
+    WavReader reader;
+    if (! reader.open(argv[1]))
+    {
+        std::fprintf(stderr, "Can't read %s (PCM 16/24/32-bit or 32-bit float WAV, up to %d channels)\n",
+                     argv[1], IsolatorCore::maxChannels);
+        return 2;
+    }
+
+    const double windowSeconds = numberArg(argc, argv, "--window", BandAnalyzer::defaultWindowSeconds);
+    const int blockSize = std::max(16, (int) numberArg(argc, argv, "--block", 4096.0));
+    const char* outputPath = stringArg(argc, argv, "--output", nullptr);
+
+    std::unique_ptr<std::FILE, FileCloser> outputFile;
+    if (outputPath != nullptr)
+    {
+        outputFile.reset(std::fopen(outputPath, "w"));
+        if (outputFile == nullptr)
+        {
+            std::fprintf(stderr, "Can't write %s\n", outputPath);
+            return 2;
+        }
+    }
+    std::FILE* csv = outputFile != nullptr ? outputFile.get() : stdout;
+    std::FILE* report = outputFile != nullptr ? stdout : stderr;
+
+    // Analysis-only: split and measure, no dynamics or mix
+    auto core = std::make_unique<IsolatorCore>();
+    auto analyzer = std::make_unique<BandAnalyzer>();
+    core->prepare(reader.sampleRate, blockSize, reader.numChannels);
+    analyzer->prepare(reader.sampleRate, reader.numChannels);
+    analyzer->setWindowSeconds(windowSeconds);
+    analyzer->reset();
+    core->setAnalyzer(analyzer.get(), true);
+
+    std::fprintf(csv, "start_s,length_s");
+    for (const char* band : bandNames)
+        std::fprintf(csv, ",%s_rms_db,%s_peak_db,%s_lufs", band, band, band);
+    std::fprintf(csv, "\n");
+
+    Summary summary;
+    auto drain = [&]
+    {
+        BandAnalyzer::Frame frame;
+        while (analyzer->pop(frame))
+        {
+            std::fprintf(csv, "%.6f,%.6f", (double) frame.firstSample / reader.sampleRate, frame.numSamples / reader.sampleRate);
+            for (int band = 0; band < BandAnalyzer::numBands; ++band)
+                std::fprintf(csv, ",%.2f,%.2f,%.2f", (double) frame.rmsDb[band], (double) frame.peakDb[band], (double) frame.loudnessLufs[band]);
+            std::fprintf(csv, "\n");
+            summary.add(frame);
+        }
+    };
+
+    std::vector<std::vector<float>> channels((size_t) reader.numChannels, std::vector<float>((size_t) blockSize));
+    std::vector<float*> channelPointers;
+    for (auto& channel : channels)
+        channelPointers.push_back(channel.data());
+
+    double processSeconds = 0.0;
+    for (int n; (n = reader.read(channels, blockSize)) > 0;)
+    {
+        const auto start = Clock::now();
+        core->process(channelPointers.data(), reader.numChannels, n);
+        processSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        drain(); // every block, so the queue never fills
+    }
+
+    analyzer->flush();
+    drain();
+
+    //==============================================================================
+    const double seconds = (double) summary.numSamples / reader.sampleRate;
+    std::fprintf(report, "%s: %d ch @ %.0f Hz, %.2f s in %d window(s) of %.3f s, kernels %s\n",
+                 argv[1], reader.numChannels, reader.sampleRate, seconds, summary.numFrames, windowSeconds, DspKernels::get().name);
+    std::fprintf(report, "  %-8s %10s %10s %10s\n", "band", "RMS dBFS", "peak dBFS", "LUFS");
+    for (int band = 0; band < BandAnalyzer::numBands; ++band)
+    {
+        const double samples = (double) std::max<std::uint64_t>(1, summary.numSamples);
+        const double rms = summary.power[band] > 0.0 ? 10.0 * std::log10(summary.power[band] / samples) : BandAnalyzer::floorDecibels;
+        const double lufs = summary.weightedPower[band] > 0.0 ? -0.691 + 10.0 * std::log10(summary.weightedPower[band] / samples)
+                                                              : BandAnalyzer::floorDecibels;
+        std::fprintf(report, "  %-8s %10.2f %10.2f %10.2f\n", bandNames[band], rms, (double) summary.peakDb[band], lufs);
+    }
+    std::fprintf(report, "  analysis %.1fx realtime\n", processSeconds > 0.0 ? seconds / processSeconds : 0.0);
+    if (analyzer->getNumDropped() > 0)
+        std::fprintf(report, "  %d window(s) dropped\n", analyzer->getNumDropped());
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Headless benchmark of the JUCE-free core library (EQIsolator4Core).
+//
+// Links nothing but the core, so its own file size is the footprint a server
+// process pays for the isolator. Reports:
+//   - size of this executable
+//   - cold start: main() to the first processed block (CPU dispatch, prepare, first process)
+//   - warm instantiate + prepare cost per instance
+//   - processing speed as a multiple of realtime
+//
+// Usage: EQIsolator4CoreBench [--rate SR] [--block B] [--seconds S] [--instances N]
+
+#include "IsolatorCore.h"
+#include "StageProfiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    long long fileSize(const char* path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return file ? (long long) file.tellg() : -1;
+    }
+
+    double numberArg(int argc, char** argv, const char* name, double fallback)
+    {
+        for (int i = 1; i + 1 < argc; ++i)
+            if (std::strcmp(argv[i], name) == 0)
+                return std::atof(argv[i + 1]);
+        return fallback;
+    }
+
+    // Deterministic noise plus a low sine, so every band carries signal
+    void fillInput(std::vector<std::vector<float>>& channels, double sampleRate, long long firstSample)
+    {
+        unsigned int seed = 0x1234567u + (unsigned int) firstSample;
+        for (size_t c = 0; c < channels.size(); ++c)
+        {
+            auto& data = channels[c];
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const double t = (double) (firstSample + (long long) i) / sampleRate;
+                data[i] = 0.25f * (float) std::sin(2.0 * 3.141592653589793 * 60.0 * t)
+                        + 0.25f * ((float) (seed >> 8) / 8388608.0f - 1.0f);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto mainStart = Clock::now();
+
+   #if EQISOLATOR4_PROFILE_STAGES
+    StageProfiler::Session profilerSession;
+   #endif
+
+    const double sampleRate = numberArg(argc, argv, "--rate", 48000.0);
+    const int blockSize = (int) numberArg(argc, argv, "--block", 256.0);
+    const double seconds = numberArg(argc, argv, "--seconds", 60.0);
+    const int numInstances = (int) numberArg(argc, argv, "--instances", 100.0);
+    const int numChannels = 2;
+
+    std::vector<std::vector<float>> input((size_t) numChannels, std::vector<float>((size_t) blockSize));
+    std::vector<float*> channelPointers;
+    for (auto& channel : input)
+        channelPointers.push_back(channel.data());
+
+    // Cold start: first instance, first block
+    auto core = std::make_unique<IsolatorCore>();
+    core->setParameter(IsolatorCore::lowGain, -6.0f);
+    core->setParameter(IsolatorCore::highGain, 3.0f);
+    core->prepare(sampleRate, blockSize, numChannels);
+    fillInput(input, sampleRate, 0);
+    core->process(channelPointers.data(), numChannels, blockSize);
+    const double coldStartMs = millisecondsSince(mainStart);
+
+    // Warm instantiate + prepare
+    const auto instancesStart = Clock::now();
+    {
+        std::vector<std::unique_ptr<IsolatorCore>> instances;
+        for (int i = 0; i < numInstances; ++i)
+        {
+            instances.push_back(std::make_unique<IsolatorCore>());
+            instances.back()->setState(core->getState());
+            instances.back()->prepare(sampleRate, blockSize, numChannels);
+        }
+    }
+    const double perInstanceMs = millisecondsSince(instancesStart) / std::max(1, numInstances);
+
+    // Throughput
+    const long long totalBlocks = (long long) (seconds * sampleRate / blockSize);
+    double processSeconds = 0.0;
+    for (long long block = 0; block < totalBlocks; ++block)
+    {
+        fillInput(input, sampleRate, block * blockSize);
+        const auto start = Clock::now();
+        core->process(channelPointers.data(), numChannels, blockSize);
+        processSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::printf("EQIsolator4 core: %d ch @ %.0f Hz, %d-sample blocks, kernels %s\n",
+                numChannels, sampleRate, blockSize, DspKernels::get().name);
+    std::printf("  executable size     %lld bytes\n", fileSize(argv[0]));
+    std::printf("  cold start          %.3f ms (main to first processed block)\n", coldStartMs);
+    std::printf("  instantiate+prepare %.3f ms per instance (%d instances)\n", perInstanceMs, numInstances);
+    std::printf("  processing          %.1fx realtime (%.0f s of audio)\n",
+                processSeconds > 0.0 ? (double) totalBlocks * blockSize / sampleRate / processSeconds : 0.0,
+                (double) totalBlocks * blockSize / sampleRate);
+    return 0;
+}
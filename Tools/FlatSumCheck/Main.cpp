@@ -0,0 +1,119 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Checks that the offline engine's bands (Source/HighQualityEngine.h) sum flat.
+//
+// Renders an impulse through the offline engine with every band at unity and measures
+// how far the magnitude of the flat sum strays from 0 dB, at each sample rate given
+// (by default the common ones from 44.1 to 192 kHz). The exit code is non-zero if any
+// rate is out of tolerance.
+//
+// Usage: EQIsolator4FlatSumCheck [--rate SR] [--block B]
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "HighQualityEngine.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // The engine's LR8 tree sums to an allpass, so its flat sum (impulse response, all four
+    // bands added) should be 0 dB: measured from 40 Hz, where the 5 Hz DC blocker on the
+    // Low band takes less than 0.07 dB, to 20 kHz, below 0.4 x the rate where the
+    // oversampling filters are flat.
+    constexpr double flatSumToleranceDb = 0.1;
+
+    double measureFlatSumDeviationDb(double sampleRate, int blockSize)
+    {
+        constexpr int numBands = HighQualityEngine::numBands;
+        constexpr int order = 16; // covers the 5 Hz DC blocker's tail
+        constexpr int length = 1 << order;
+
+        std::vector<float> impulse((size_t) length, 0.0f);
+        impulse[0] = 1.0f;
+
+        // Interleaved complex layout for the FFT: the first half holds the signal
+        std::vector<float> sum((size_t) (2 * length), 0.0f);
+
+        HighQualityEngine engine;
+        engine.prepare(sampleRate, blockSize, 1);
+
+        std::vector<float> engineBands((size_t) (numBands * blockSize));
+        float* engineChannels[numBands];
+        float* const* engineOutputs[numBands];
+        for (int band = 0; band < numBands; ++band)
+        {
+            engineChannels[band] = engineBands.data() + band * blockSize;
+            engineOutputs[band] = &engineChannels[band];
+        }
+
+        for (int start = 0; start < length; start += blockSize)
+        {
+            const int n = juce::jmin(blockSize, length - start);
+            const float* input = impulse.data() + start;
+
+            engine.process(&input, 1, n, engineOutputs);
+
+            for (int band = 0; band < numBands; ++band)
+                for (int i = 0; i < n; ++i)
+                    sum[(size_t) (start + i)] += engineChannels[band][i];
+        }
+
+        juce::dsp::FFT fft(order);
+        fft.performFrequencyOnlyForwardTransform(sum.data());
+
+        const double highest = juce::jmin(20000.0, 0.4 * sampleRate);
+        double largest = 0.0;
+        for (int bin = 1; bin <= length / 2; ++bin)
+        {
+            const double frequency = bin * sampleRate / length;
+            if (frequency < 40.0 || frequency > highest)
+                continue;
+
+            const double deviation = juce::Decibels::gainToDecibels((double) sum[(size_t) bin], -200.0);
+            largest = juce::jmax(largest, std::abs(deviation));
+        }
+        return largest;
+    }
+
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto intArg = [&args](const char* name, int fallback)
+    {
+        const int index = args.indexOf(name);
+        return index >= 0 && index + 1 < args.size() ? args[index + 1].getIntValue() : fallback;
+    };
+
+    const int blockSize = juce::jlimit(16, 8192, intArg("--block", 256));
+    std::vector<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    const int rate = intArg("--rate", 0);
+    if (rate > 0)
+        sampleRates = { (double) juce::jlimit(22050, 384000, rate) };
+
+    std::printf("EQIsolator4 offline engine flat sum (%d-sample blocks, tolerance %.2f dB)\n",
+                blockSize, flatSumToleranceDb);
+
+    bool allFlat = true;
+    for (const double sampleRate : sampleRates)
+    {
+        const double deviationDb = measureFlatSumDeviationDb(sampleRate, blockSize);
+        const bool flat = deviationDb <= flatSumToleranceDb;
+        allFlat = allFlat && flat;
+        std::printf("  %6.0f Hz  %.3f dB max deviation%s\n", sampleRate, deviationDb, flat ? "" : "  FAILED");
+    }
+
+    return allFlat ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Replays a flight recorder capture (Source/FlightRecorder.h) through the processor.
+//
+// Feeds the recorded input back block by block, with the recorded block sizes,
+// parameter values and realtime/offline flag, into a freshly prepared
+// processor, and reports:
+//   - the recorded blocks that took longest live, against the replayed cost
+//     of the same blocks (fastest of all passes, so noise doesn't hide them)
+//   - total replay cost as a share of real time
+//   - whether every pass rendered bit-identical output
+//
+// The CPU governor is held off (it reacts to timing, so the output would
+// depend on this machine); the tier it was in live is shown per block. The
+// filter state at the start of the capture isn't recorded, so the first
+// blocks settle from silence; the parameters start at the recorded values.
+//
+// Usage: EQIsolator4FlightReplay <capture.eq4f> [--repeat N] [--top K] [--output out.wav]
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace
+{
+    struct Options
+    {
+        juce::String capturePath;
+        int repeat = 3;
+        int top = 10;
+        juce::String outputPath;
+
+        static Options parse(const juce::StringArray& args)
+        {
+            Options options;
+            auto intArg = [&args](const char* name, int fallback)
+            {
+                const int index = args.indexOf(name);
+                return index >= 0 && index + 1 < args.size() ? args[index + 1].getIntValue() : fallback;
+            };
+
+            options.repeat = juce::jlimit(1, 1000, intArg("--repeat", options.repeat));
+            options.top    = juce::jlimit(1, 1000, intArg("--top", options.top));
+
+            const int outputIndex = args.indexOf("--output");
+            if (outputIndex >= 0 && outputIndex + 1 < args.size())
+                options.outputPath = args[outputIndex + 1];
+
+            if (args.size() > 0 && ! args[0].startsWith("--"))
+                options.capturePath = args[0];
+            return options;
+        }
+    };
+
+    double ticksToMs(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+    }
+
+    // Capture parameter index -> the processor's parameter with that ID (null if it no longer exists)
+    std::vector<juce::AudioProcessorParameter*> mapParameters(EQIsolator4AudioProcessor& processor,
+                                                              const FlightRecorder::Capture& capture)
+    {
+        std::vector<juce::AudioProcessorParameter*> mapped(capture.parameterIds.size(), nullptr);
+        for (auto* parameter : processor.getParameters())
+            if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+                for (size_t i = 0; i < capture.parameterIds.size(); ++i)
+                    if (withId->paramID == juce::String(capture.parameterIds[i]))
+                        mapped[i] = parameter;
+        return mapped;
+    }
+
+    void applyParameters(EQIsolator4AudioProcessor& processor, const std::vector<juce::AudioProcessorParameter*>& parameters,
+                         const FlightRecorder::Block& block)
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+            if (parameters[i] != nullptr && parameters[i]->getValue() != block.parameters[i])
+                parameters[i]->setValue(block.parameters[i]);
+
+        // Timing-driven, so never replayed
+        processor.governorParam->setValue(0.0f);
+        processor.setNonRealtime((block.flags & FlightRecorder::flagNonRealtime) != 0);
+    }
+
+    // Prepared with the first block's parameters, so the smoothers start where the capture does
+    std::unique_ptr<EQIsolator4AudioProcessor> createPrepared(const FlightRecorder::Capture& capture,
+                                                              std::vector<juce::AudioProcessorParameter*>& parameters)
+    {
+        auto processor = std::make_unique<EQIsolator4AudioProcessor>();
+
+        if (capture.numChannels == 1)
+        {
+            auto layout = processor->getBusesLayout();
+            layout.inputBuses.getReference(0) = juce::AudioChannelSet::mono();
+            layout.outputBuses.getReference(0) = juce::AudioChannelSet::mono();
+            processor->setBusesLayout(layout);
+        }
+
+        parameters = mapParameters(*processor, capture);
+        applyParameters(*processor, parameters, capture.blocks.front());
+
+        processor->setRateAndBufferSizeDetails(capture.sampleRate, capture.maximumBlockSize);
+        processor->prepareToPlay(capture.sampleRate, capture.maximumBlockSize);
+        return processor;
+    }
+
+    // FNV-1a over the output bits, to compare passes without keeping them
+    struct OutputHash
+    {
+        juce::uint64 value = 14695981039346656037ull;
+
+        void add(const float* data, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                juce::uint32 bits;
+                std::memcpy(&bits, data + i, sizeof(bits));
+                value = (value ^ bits) * 1099511628211ull;
+            }
+        }
+    };
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    const auto options = Options::parse(args);
+    if (options.capturePath.isEmpty())
+    {
+        std::printf("Usage: EQIsolator4FlightReplay <capture.eq4f> [--repeat N] [--top K] [--output out.wav]\n");
+        return 2;
+    }
+
+    FlightRecorder::Capture capture;
+    if (! capture.load(options.capturePath.toStdString()))
+    {
+        std::printf("Can't read capture %s\n", options.capturePath.toRawUTF8());
+        return 2;
+    }
+
+    const int numBlocks = (int) capture.blocks.size();
+    const juce::int64 numSamples = std::accumulate(capture.blocks.begin(), capture.blocks.end(), (juce::int64) 0,
+                                                   [](juce::int64 sum, const FlightRecorder::Block& block) { return sum + block.numSamples; });
+    const double seconds = (double) numSamples / capture.sampleRate;
+
+    std::printf("Capture %s: %s, %d blocks (%.2f s) of %d channel(s) @ %.0f Hz, max block %d\n",
+                options.capturePath.toRawUTF8(), capture.reason == FlightRecorder::reasonOverrun ? "deadline overrun" : "requested",
+                numBlocks, seconds, capture.numChannels, capture.sampleRate, capture.maximumBlockSize);
+    std::printf("DSP kernels: %s (EQISOLATOR4_ISA / EQISOLATOR4_DETERMINISTIC to override)\n", DspKernels::get().name);
+
+    //==============================================================================
+    std::vector<double> fastestMs((size_t) numBlocks, 0.0);
+    std::vector<juce::uint64> passHashes;
+    double bestPassMs = 0.0;
+    int unmappedParameters = 0;
+
+    juce::AudioBuffer<float> buffer(capture.numChannels, capture.maximumBlockSize);
+    juce::AudioBuffer<float> rendered;
+    if (options.outputPath.isNotEmpty())
+        rendered.setSize(capture.numChannels, (int) numSamples);
+    juce::MidiBuffer midi;
+
+    for (int pass = 0; pass < options.repeat; ++pass)
+    {
+        std::vector<juce::AudioProcessorParameter*> parameters;
+        auto processor = createPrepared(capture, parameters);
+        unmappedParameters = (int) std::count(parameters.begin(), parameters.end(), nullptr);
+
+        OutputHash hash;
+        double passMs = 0.0;
+        int position = 0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            const auto& block = capture.blocks[(size_t) b];
+            const int n = (int) block.numSamples;
+
+            applyParameters(*processor, parameters, block);
+
+            buffer.setSize(capture.numChannels, n, false, false, true);
+            for (int ch = 0; ch < capture.numChannels; ++ch)
+                buffer.copyFrom(ch, 0, block.input.data() + (size_t) ch * block.numSamples, n);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor->processBlock(buffer, midi);
+            const double ms = ticksToMs(juce::Time::getHighResolutionTicks() - start);
+
+            passMs += ms;
+            fastestMs[(size_t) b] = pass == 0 ? ms : juce::jmin(fastestMs[(size_t) b], ms);
+
+            for (int ch = 0; ch < capture.numChannels; ++ch)
+            {
+                hash.add(buffer.getReadPointer(ch), n);
+                if (rendered.getNumSamples() > 0)
+                    rendered.copyFrom(ch, position, buffer, ch, 0, n);
+            }
+            position += n;
+        }
+
+        passHashes.push_back(hash.value);
+        bestPassMs = pass == 0 ? passMs : juce::jmin(bestPassMs, passMs);
+    }
+
+    //==============================================================================
+    std::vector<int> order((size_t) numBlocks);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&capture](int a, int b)
+    {
+        return capture.blocks[(size_t) a].elapsedMs > capture.blocks[(size_t) b].elapsedMs;
+    });
+
+    std::printf("\nSlowest blocks live (replayed: fastest of %d pass(es))\n", options.repeat);
+    std::printf("  %8s %9s %7s %10s %8s %10s %6s\n", "block", "time (s)", "size", "live ms", "% dl", "replay ms", "tier");
+
+    juce::int64 blockStart = 0;
+    std::vector<juce::int64> blockStarts((size_t) numBlocks);
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        blockStarts[(size_t) b] = blockStart;
+        blockStart += capture.blocks[(size_t) b].numSamples;
+    }
+
+    for (int rank = 0; rank < juce::jmin(options.top, numBlocks); ++rank)
+    {
+        const int b = order[(size_t) rank];
+        const auto& block = capture.blocks[(size_t) b];
+        const double deadlineMs = 1000.0 * block.numSamples / capture.sampleRate;
+        std::printf("  %8d %9.3f %7u %10.3f %7.1f%% %10.3f %6d%s\n", b, (double) blockStarts[(size_t) b] / capture.sampleRate,
+                    block.numSamples, (double) block.elapsedMs, 100.0 * block.elapsedMs / deadlineMs, fastestMs[(size_t) b],
+                    (int) block.governorTier, (block.flags & FlightRecorder::flagNonRealtime) != 0 ? " offline" : "");
+    }
+
+    const bool identical = std::all_of(passHashes.begin(), passHashes.end(), [&passHashes](juce::uint64 h) { return h == passHashes.front(); });
+
+    std::printf("\nReplay\n");
+    std::printf("  fastest pass     %10.2f ms for %.2f s of audio (%.1f%% of real time)\n",
+                bestPassMs, seconds, 100.0 * bestPassMs / (seconds * 1000.0));
+    std::printf("  passes           %10d, output %s\n", options.repeat, identical ? "bit-identical" : "DIFFERS between passes");
+    if (unmappedParameters > 0)
+        std::printf("  %d recorded parameter(s) unknown to this build, left at their defaults\n", unmappedParameters);
+
+    if (options.outputPath.isNotEmpty())
+    {
+        const juce::File outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(options.outputPath);
+        outputFile.deleteFile();
+
+        // 32-bit float, so the file holds exactly what the processor produced
+        juce::WavAudioFormat wav;
+        auto stream = std::make_unique<juce::FileOutputStream>(outputFile);
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (stream->openedOk())
+            writer.reset(wav.createWriterFor(stream.get(), capture.sampleRate, (unsigned int) capture.numChannels, 32, {}, 0));
+        if (writer != nullptr)
+            stream.release(); // owned by the writer
+
+        if (writer != nullptr && writer->writeFromAudioSampleBuffer(rendered, 0, rendered.getNumSamples()))
+            std::printf("  output written to %s\n", outputFile.getFullPathName().toRawUTF8());
+        else
+            std::printf("  can't write %s\n", outputFile.getFullPathName().toRawUTF8());
+    }
+
+    return identical ? 0 : 1;
+}
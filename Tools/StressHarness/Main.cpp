@@ -0,0 +1,420 @@
+/*
+ EQIsolator4 - A transparent 4-band equalizer VST3 plugin
+ Copyright (C) 2025 ivaoniria
+ Licensed under GPL v3: https://www.gnu.org/licenses/gpl-3.0.en.html
+*/
+
+// Headless multi-instance stress harness.
+//
+// Instantiates N processors, splits them across host-like worker threads that
+// run in lockstep (one "audio callback" per block), drives every instance with
+// deterministic automation and reports:
+//   - instantiate / prepare / destroy times
+//   - resident memory per instance
+//   - total and worst-case callback time against the block deadline
+//   - cross-instance interference: every instance is compared sample by sample
+//     with a reference rendered alone with the same automation profile
+//
+// Usage: EQIsolator4StressHarness [--instances N] [--threads T] [--block B]
+//                                 [--rate SR] [--seconds S] [--profiles P]
+//                                 [--bypassed PERCENT]
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#elif JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment(lib, "psapi")
+#endif
+
+namespace
+{
+    //==============================================================================
+    struct Options
+    {
+        int numInstances = 300;
+        int numThreads = juce::jmax(1, juce::SystemStats::getNumCpus() / 2);
+        int blockSize = 256;
+        double sampleRate = 48000.0;
+        double seconds = 10.0;
+        int numProfiles = 4;
+        int bypassedPercent = 0; // share of profiles host-bypassed for the whole run
+
+        static Options parse(const juce::StringArray& args)
+        {
+            Options options;
+            auto intArg = [&args](const char* name, int fallback)
+            {
+                const int index = args.indexOf(name);
+                return index >= 0 && index + 1 < args.size() ? args[index + 1].getIntValue() : fallback;
+            };
+
+            options.numInstances = juce::jmax(1, intArg("--instances", options.numInstances));
+            options.numThreads   = juce::jlimit(1, 64, intArg("--threads", options.numThreads));
+            options.blockSize    = juce::jlimit(16, 8192, intArg("--block", options.blockSize));
+            options.sampleRate   = (double) juce::jlimit(22050, 384000, intArg("--rate", (int) options.sampleRate));
+            options.seconds      = (double) juce::jmax(1, intArg("--seconds", (int) options.seconds));
+            options.numProfiles  = juce::jlimit(1, 16, intArg("--profiles", options.numProfiles));
+            options.bypassedPercent = juce::jlimit(0, 100, intArg("--bypassed", options.bypassedPercent));
+            return options;
+        }
+    };
+
+    // Resident set size of this process, 0 where unsupported
+    juce::int64 getResidentBytes()
+    {
+       #if JUCE_LINUX
+        long pages = 0, resident = 0;
+        if (auto* file = std::fopen("/proc/self/statm", "r"))
+        {
+            if (std::fscanf(file, "%ld %ld", &pages, &resident) != 2)
+                resident = 0;
+            std::fclose(file);
+        }
+        return (juce::int64) resident * (juce::int64) sysconf(_SC_PAGESIZE);
+       #elif JUCE_MAC
+        mach_task_basic_info info {};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) != KERN_SUCCESS)
+            return 0;
+        return (juce::int64) info.resident_size;
+       #elif JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters {};
+        if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+        return (juce::int64) counters.WorkingSetSize;
+       #else
+        return 0;
+       #endif
+    }
+
+    double ticksToMs(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+    }
+
+    //==============================================================================
+    // Static configuration and per-block automation of one profile; a pure
+    // function of (profile, block) so the reference and the stress run agree.
+    void configure(EQIsolator4AudioProcessor& processor, int profile, bool hostBypassed)
+    {
+        // The governor reacts to timing, which would make outputs non-deterministic
+        processor.governorParam->setValue(0.0f);
+        processor.bypassParam->setValue(hostBypassed ? 1.0f : 0.0f);
+        processor.multirateParam->setValue(profile % 3 == 1 ? 1.0f : 0.0f);
+        processor.limiterModeParam->setValue(processor.limiterModeParam->convertTo0to1((float) (profile % 4)));
+    }
+
+    void automate(EQIsolator4AudioProcessor& processor, int profile, juce::int64 block, double blockSeconds)
+    {
+        const double t = (double) block * blockSeconds;
+        const double rate = 0.13 + 0.07 * profile;
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        auto setDecibels = [](juce::AudioParameterFloat* parameter, double decibels)
+        {
+            parameter->setValue(parameter->convertTo0to1((float) decibels));
+        };
+
+        setDecibels(processor.lowGainParam,    -9.0 + 12.0 * std::sin(twoPi * rate * t));
+        setDecibels(processor.lowMidGainParam, -6.0 + 9.0 * std::sin(twoPi * rate * 1.7 * t + 1.0));
+        setDecibels(processor.midGainParam,    -3.0 + 6.0 * std::sin(twoPi * rate * 2.3 * t + 2.0));
+        setDecibels(processor.highGainParam,   -12.0 + 18.0 * std::sin(twoPi * rate * 0.6 * t + 3.0));
+
+        // A band bypass toggling every few seconds, as a performer would
+        const bool bypassed = ((juce::int64) (t / (1.5 + 0.5 * profile)) % 2) == 1;
+        juce::AudioParameterBool* const bypasses[] = { processor.lowBypassParam, processor.lowMidBypassParam,
+                                                       processor.midBypassParam, processor.highBypassParam };
+        bypasses[profile % 4]->setValue(bypassed ? 1.0f : 0.0f);
+    }
+
+    //==============================================================================
+    // Shared, read-only input: a few seconds of noise plus a slow sweep, looped
+    struct InputSignal
+    {
+        juce::AudioBuffer<float> buffer;
+
+        InputSignal(double sampleRate, int numChannels)
+        {
+            const int length = (int) (sampleRate * 3.0);
+            buffer.setSize(numChannels, length);
+
+            juce::Random random(0x5eed);
+            double phase = 0.0;
+            for (int i = 0; i < length; ++i)
+            {
+                const double frequency = 30.0 * std::pow(400.0, (double) i / length);
+                phase += juce::MathConstants<double>::twoPi * frequency / sampleRate;
+                const float sweep = 0.3f * (float) std::sin(phase);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    buffer.setSample(ch, i, sweep + 0.2f * (random.nextFloat() * 2.0f - 1.0f));
+            }
+        }
+
+        void copyBlock(juce::AudioBuffer<float>& destination, juce::int64 block, int blockSize) const
+        {
+            const int length = buffer.getNumSamples();
+            int position = (int) ((block * blockSize) % length);
+
+            for (int written = 0; written < blockSize;)
+            {
+                const int n = juce::jmin(blockSize - written, length - position);
+                for (int ch = 0; ch < destination.getNumChannels(); ++ch)
+                    destination.copyFrom(ch, written, buffer, ch % buffer.getNumChannels(), position, n);
+                written += n;
+                position = 0;
+            }
+        }
+    };
+
+    //==============================================================================
+    struct Instance
+    {
+        std::unique_ptr<EQIsolator4AudioProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        int profile = 0;
+        float maxDeviation = 0.0f;
+        double worstBlockMs = 0.0;
+    };
+
+    std::unique_ptr<EQIsolator4AudioProcessor> createPrepared(const Options& options)
+    {
+        auto processor = std::make_unique<EQIsolator4AudioProcessor>();
+        processor->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+        processor->prepareToPlay(options.sampleRate, options.blockSize);
+        return processor;
+    }
+
+    // Lockstep barrier for the simulated audio callbacks
+    class Barrier
+    {
+    public:
+        explicit Barrier(int count) : threshold(count), remaining(count) {}
+
+        void arriveAndWait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            const auto arrivalGeneration = generation;
+            if (--remaining == 0)
+            {
+                ++generation;
+                remaining = threshold;
+                condition.notify_all();
+                return;
+            }
+            condition.wait(lock, [this, arrivalGeneration] { return generation != arrivalGeneration; });
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        const int threshold;
+        int remaining;
+        juce::int64 generation = 0;
+    };
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    const auto options = Options::parse(args);
+    const int numChannels = 2;
+    const juce::int64 numBlocks = (juce::int64) (options.seconds * options.sampleRate / options.blockSize);
+    const double blockSeconds = options.blockSize / options.sampleRate;
+    const int numProfiles = juce::jmin(options.numProfiles, options.numInstances);
+    const int numBypassedProfiles = juce::roundToInt(numProfiles * options.bypassedPercent / 100.0);
+    auto isBypassedProfile = [numBypassedProfiles](int profile) { return profile < numBypassedProfiles; };
+
+    std::printf("EQIsolator4 stress harness: %d instances, %d threads, %d samples @ %.0f Hz, %.0f s (%lld blocks)\n",
+                options.numInstances, options.numThreads, options.blockSize, options.sampleRate,
+                options.seconds, (long long) numBlocks);
+    std::printf("DSP kernels: %s (EQISOLATOR4_ISA / EQISOLATOR4_DETERMINISTIC to override)\n", DspKernels::get().name);
+    if (numBypassedProfiles > 0)
+        std::printf("Host-bypassed: %d of %d profile(s)\n", numBypassedProfiles, numProfiles);
+
+    const InputSignal input(options.sampleRate, numChannels);
+
+    //==============================================================================
+    // References: each profile rendered by a lone instance
+    std::vector<std::vector<float>> references((size_t) numProfiles);
+    {
+        juce::AudioBuffer<float> buffer(numChannels, options.blockSize);
+        juce::MidiBuffer midi;
+
+        for (int profile = 0; profile < numProfiles; ++profile)
+        {
+            auto processor = createPrepared(options);
+            configure(*processor, profile, isBypassedProfile(profile));
+
+            auto& reference = references[(size_t) profile];
+            reference.resize((size_t) (numBlocks * numChannels * options.blockSize));
+
+            for (juce::int64 block = 0; block < numBlocks; ++block)
+            {
+                input.copyBlock(buffer, block, options.blockSize);
+                automate(*processor, profile, block, blockSeconds);
+                processor->processBlock(buffer, midi);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    std::copy(buffer.getReadPointer(ch), buffer.getReadPointer(ch) + options.blockSize,
+                              reference.begin() + (std::ptrdiff_t) ((block * numChannels + ch) * options.blockSize));
+            }
+        }
+    }
+
+    //==============================================================================
+    // Instantiate and prepare
+    std::vector<Instance> instances((size_t) options.numInstances);
+    const auto memoryBefore = getResidentBytes();
+
+    const auto instantiateStart = juce::Time::getHighResolutionTicks();
+    for (auto& instance : instances)
+        instance.processor = std::make_unique<EQIsolator4AudioProcessor>();
+    const auto instantiateTicks = juce::Time::getHighResolutionTicks() - instantiateStart;
+
+    const auto prepareStart = juce::Time::getHighResolutionTicks();
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        auto& instance = instances[i];
+        instance.processor->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+        instance.processor->prepareToPlay(options.sampleRate, options.blockSize);
+        instance.buffer.setSize(numChannels, options.blockSize);
+        instance.profile = (int) (i % (size_t) numProfiles);
+        configure(*instance.processor, instance.profile, isBypassedProfile(instance.profile));
+    }
+    const auto prepareTicks = juce::Time::getHighResolutionTicks() - prepareStart;
+
+    const auto memoryAfter = getResidentBytes();
+
+    //==============================================================================
+    // Run: worker w owns instances w, w + T, w + 2T, ... and all workers meet at
+    // the barrier once per block, like the threads of a host's audio callback.
+    // Outputs are checked against the references after the end barrier, outside
+    // the timed callback; the next callback only starts once that is done.
+    const int numThreads = juce::jmin(options.numThreads, options.numInstances);
+    Barrier startBarrier(numThreads + 1), endBarrier(numThreads + 1), checkedBarrier(numThreads + 1);
+    std::vector<double> workerBlockMs((size_t) numThreads, 0.0);
+
+    auto worker = [&](int workerIndex)
+    {
+        for (juce::int64 block = 0; block < numBlocks; ++block)
+        {
+            startBarrier.arriveAndWait();
+            const auto workerStart = juce::Time::getHighResolutionTicks();
+
+            for (size_t i = (size_t) workerIndex; i < instances.size(); i += (size_t) numThreads)
+            {
+                auto& instance = instances[i];
+                input.copyBlock(instance.buffer, block, options.blockSize);
+                automate(*instance.processor, instance.profile, block, blockSeconds);
+
+                const auto instanceStart = juce::Time::getHighResolutionTicks();
+                instance.processor->processBlock(instance.buffer, instance.midi);
+                instance.worstBlockMs = juce::jmax(instance.worstBlockMs,
+                                                   ticksToMs(juce::Time::getHighResolutionTicks() - instanceStart));
+            }
+
+            workerBlockMs[(size_t) workerIndex] = ticksToMs(juce::Time::getHighResolutionTicks() - workerStart);
+            endBarrier.arriveAndWait();
+
+            // The buffers still hold this block's output until the next copyBlock
+            for (size_t i = (size_t) workerIndex; i < instances.size(); i += (size_t) numThreads)
+            {
+                auto& instance = instances[i];
+                const auto& reference = references[(size_t) instance.profile];
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    const float* output = instance.buffer.getReadPointer(ch);
+                    const float* expected = reference.data() + (block * numChannels + ch) * options.blockSize;
+                    for (int s = 0; s < options.blockSize; ++s)
+                        instance.maxDeviation = juce::jmax(instance.maxDeviation, std::abs(output[s] - expected[s]));
+                }
+            }
+
+            checkedBarrier.arriveAndWait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < numThreads; ++w)
+        threads.emplace_back(worker, w);
+
+    double totalCallbackMs = 0.0, worstCallbackMs = 0.0, worstWorkerMs = 0.0;
+    juce::int64 missedDeadlines = 0;
+    const double deadlineMs = blockSeconds * 1000.0;
+
+    for (juce::int64 block = 0; block < numBlocks; ++block)
+    {
+        const auto callbackStart = juce::Time::getHighResolutionTicks();
+        startBarrier.arriveAndWait();
+        endBarrier.arriveAndWait();
+        const double callbackMs = ticksToMs(juce::Time::getHighResolutionTicks() - callbackStart);
+
+        totalCallbackMs += callbackMs;
+        worstCallbackMs = juce::jmax(worstCallbackMs, callbackMs);
+        for (double ms : workerBlockMs)
+            worstWorkerMs = juce::jmax(worstWorkerMs, ms);
+        missedDeadlines += callbackMs > deadlineMs ? 1 : 0;
+
+        checkedBarrier.arriveAndWait();
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    //==============================================================================
+    float worstDeviation = 0.0f;
+    int interferingInstances = 0;
+    double worstInstanceBlockMs = 0.0;
+    for (const auto& instance : instances)
+    {
+        worstDeviation = juce::jmax(worstDeviation, instance.maxDeviation);
+        interferingInstances += instance.maxDeviation > 0.0f ? 1 : 0;
+        worstInstanceBlockMs = juce::jmax(worstInstanceBlockMs, instance.worstBlockMs);
+    }
+
+    const auto destroyStart = juce::Time::getHighResolutionTicks();
+    instances.clear();
+    const auto destroyTicks = juce::Time::getHighResolutionTicks() - destroyStart;
+
+    //==============================================================================
+    const double n = (double) options.numInstances;
+    std::printf("\nLifecycle\n");
+    std::printf("  instantiate      %10.2f ms total  %8.3f ms/instance\n", ticksToMs(instantiateTicks), ticksToMs(instantiateTicks) / n);
+    std::printf("  prepare          %10.2f ms total  %8.3f ms/instance\n", ticksToMs(prepareTicks), ticksToMs(prepareTicks) / n);
+    std::printf("  destroy          %10.2f ms total  %8.3f ms/instance\n", ticksToMs(destroyTicks), ticksToMs(destroyTicks) / n);
+    if (memoryBefore > 0 && memoryAfter > 0)
+        std::printf("  memory           %10.1f KiB/instance (resident, after prepare)\n", (double) (memoryAfter - memoryBefore) / 1024.0 / n);
+
+    std::printf("\nCallbacks (deadline %.3f ms)\n", deadlineMs);
+    std::printf("  total            %10.2f ms for %.1f s of audio (%.1f%% of real time)\n",
+                totalCallbackMs, options.seconds, 100.0 * totalCallbackMs / (options.seconds * 1000.0));
+    std::printf("  mean             %10.3f ms\n", totalCallbackMs / (double) juce::jmax((juce::int64) 1, numBlocks));
+    std::printf("  worst callback   %10.3f ms\n", worstCallbackMs);
+    std::printf("  worst worker     %10.3f ms\n", worstWorkerMs);
+    std::printf("  worst instance   %10.3f ms (single processBlock)\n", worstInstanceBlockMs);
+    std::printf("  missed deadlines %10lld of %lld\n", (long long) missedDeadlines, (long long) numBlocks);
+
+    std::printf("\nIsolation\n");
+    std::printf("  max deviation from lone reference: %g (%d instance(s) affected)\n", (double) worstDeviation, interferingInstances);
+
+    return interferingInstances == 0 ? 0 : 1;
+}